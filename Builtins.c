@@ -8,6 +8,9 @@
 #include <string.h>  
 
 #include "Builtins.h"
+#include "quack_alloc.h"
+#include "quack_gc.h"
+#include "quack_out.h"
 
 
 /**************** 
@@ -25,7 +28,7 @@ class_Obj the_class_Obj;
 /* Constructor */
 obj_Obj new_Obj() 
 {
-    obj_Obj new_thing = (obj_Obj) malloc(sizeof(struct obj_Obj_struct));
+    obj_Obj new_thing = (obj_Obj) quack_alloc(sizeof(struct obj_Obj_struct));
     new_thing->clazz = the_class_Obj;
     return new_thing; 
 }
@@ -33,10 +36,9 @@ obj_Obj new_Obj()
 /* Obj STR method */
 obj_String Obj_method_STR(obj_Obj this) 
 {
-    char *rep = malloc(sizeof(char)*256);
-    sprintf(rep, "<Object at %p>", this);
-    obj_String str = str_literal(rep); 
-    return str;
+    char rep[32];
+    int len = snprintf(rep, 32, "<Object at %p>", this);
+    return str_new(rep, len);
 }
 
 /* Obj PRINT method */
@@ -44,7 +46,7 @@ obj_Nothing Obj_method_PRINT(obj_Obj this)
 {
     obj_String str;
     str = this->clazz->STR(this);
-    fprintf(stdout, "%s", str->text);
+    quack_out_write(str_text(str), str->len);
     return nothing;
 }
 
@@ -58,8 +60,13 @@ obj_Boolean Obj_method_EQUALS(obj_Obj this, obj_Obj other)
 }
   
 
+/* Obj has no pointer fields */
+static const size_t Obj_gc_map[] = { 0 };
+
 /* The Obj Class (a singleton) */
 struct  class_Obj_struct  the_class_Obj_struct = {
+    Obj_gc_map,
+    0, 0,        /* Numbered by main in the compiled program */
     new_Obj,     /* Constructor */
     Obj_method_STR, 
     Obj_method_PRINT, 
@@ -72,16 +79,20 @@ class_Obj the_class_Obj = &the_class_Obj_struct;
 /******************
  * String
  * Fields: 
- *    One hidden field, currently holding char*
+ *    Hidden length, hash and text; the text is inline
+ *    unless the String is a literal
  * Methods: 
  *    Those of Obj, plus ordering, concatenation 
  ******************/
 
-/* String Constructor */
+static obj_String str_alloc(int len);
+
+/* String Constructor: the empty String */
 obj_String new_String() 
 {
-    obj_String new_thing = (obj_String) malloc(sizeof(struct obj_String_struct));
+    obj_String new_thing = (obj_String) quack_alloc(sizeof(struct obj_String_struct) + 1);
     new_thing->clazz     = the_class_String;
+    new_thing->text      = new_thing->inline_text;
     return new_thing; 
 }
 
@@ -94,7 +105,7 @@ obj_String String_method_STR(obj_String this)
 /* String PRINT method */
 obj_Nothing String_method_PRINT(obj_String this) 
 {
-    fprintf(stdout, "%s", this->text);
+    quack_out_write(str_text(this), this->len);
     return nothing;
 }
   
@@ -105,35 +116,200 @@ obj_Boolean String_method_EQUALS(obj_String this, obj_Obj other)
     if (other_str->clazz != the_class_String) {
         return lit_false;
     }
+    if (this == other_str) {
+        return lit_true;
+    }
+    if (this->len != other_str->len || str_hash(this) != str_hash(other_str)) {
+        return lit_false;
+    }
 
-    if (strcmp(this->text,other_str->text) == 0) 
+    if (memcmp(str_text(this), str_text(other_str), this->len) == 0) 
         return lit_true;
     else
         return lit_false;
 }
 
+/* String PLUS (+): a rope of the two, or a copy when that is short */
+obj_String String_method_PLUS(obj_String this, obj_String other) 
+{
+    obj_String str;
+    if (this->len == 0) {
+        return other;
+    }
+    if (other->len == 0) {
+        return this;
+    }
+    if (this->len + other->len < QUACK_ROPE_MIN && this->text != NULL && other->text != NULL) {
+        str = str_alloc(this->len + other->len);
+        memcpy(str->inline_text, this->text, this->len);
+        memcpy(str->inline_text + this->len, other->text, other->len);
+        return str;
+    }
+    str = (obj_String) quack_alloc(sizeof(struct obj_String_struct));
+    str->clazz = the_class_String;
+    str->len   = this->len + other->len;
+    str->left  = this;
+    str->right = other;
+    return str;
+}
+
+/* <0, 0 or >0 as 'a' sorts before, with or after 'b', byte by byte */
+static int str_compare(obj_String a, obj_String b)
+{
+    int shorter = a->len < b->len ? a->len : b->len;
+    int order = memcmp(str_text(a), str_text(b), shorter);
+    if (order != 0) {
+        return order;
+    }
+    return a->len - b->len;
+}
+
+/* String ATMOST (<=) */
+obj_Boolean String_method_ATMOST(obj_String this, obj_String other) 
+{
+    return str_compare(this, other) <= 0 ? lit_true : lit_false;
+}
+
+/* String LESS (<) */
+obj_Boolean String_method_LESS(obj_String this, obj_String other) 
+{
+    return str_compare(this, other) < 0 ? lit_true : lit_false;
+}
+
+/* String ATLEAST (>=) */
+obj_Boolean String_method_ATLEAST(obj_String this, obj_String other) 
+{
+    return str_compare(this, other) >= 0 ? lit_true : lit_false;
+}
+
+/* String MORE (>) */
+obj_Boolean String_method_MORE(obj_String this, obj_String other) 
+{
+    return str_compare(this, other) > 0 ? lit_true : lit_false;
+}
+
+/* The text of a String is inline, static or inside 'left', so only
+ * the pieces of a rope are traced */
+static const size_t String_gc_map[] = {
+    offsetof(struct obj_String_struct, left),
+    offsetof(struct obj_String_struct, right),
+    0
+};
+
 /* The String Class (a singleton) */
 struct  class_String_struct  the_class_String_struct = {
+    String_gc_map,
+    0, 0,        /* Numbered by main in the compiled program */
     new_String,     /* Constructor */
     String_method_STR, 
     String_method_PRINT, 
-    String_method_EQUALS
+    String_method_EQUALS,
+    String_method_PLUS,
+    String_method_ATMOST,
+    String_method_LESS,
+    String_method_ATLEAST,
+    String_method_MORE
 };
 
 class_String the_class_String = &the_class_String_struct; 
 
 /* 
  * For interal use ONLY. Function to create String object 
- * Use this to create string literals. 
+ * Use this to create string literals: the text is not copied,
+ * so 's' must outlive the String
  */
 obj_String str_literal(char *s) 
 {
-    char *rep;
-    obj_String str = the_class_String->constructor(); 
-    str->text = s;
+    obj_String str = (obj_String) quack_alloc(sizeof(struct obj_String_struct));
+    str->clazz = the_class_String;
+    str->len   = (int) strlen(s);
+    str->text  = s;
+    return str;
+}
+
+/* A String with room for 'len' bytes of inline text, all NUL */
+static obj_String str_alloc(int len) 
+{
+    obj_String str = (obj_String) quack_alloc(sizeof(struct obj_String_struct) + len + 1);
+    str->clazz = the_class_String;
+    str->len   = len;
+    str->text  = str->inline_text;
     return str;
 }
 
+/* A String holding a copy of the 'len' bytes at 's', in one allocation */
+obj_String str_new(const char *s, int len) 
+{
+    obj_String str = str_alloc(len);
+    memcpy(str->inline_text, s, len);
+    return str;
+}
+
+/* Copy the text of rope 's' into a new String, which 's' keeps in
+ * 'left' from now on. Ropes built in a loop are as deep as the loop
+ * is long, so the pieces are walked with an explicit stack */
+char *str_flatten(obj_String s) 
+{
+    obj_String flat = str_alloc(s->len);
+    obj_String *stack, *grown, piece;
+    size_t top = 0, capacity = 64;
+    char *out = flat->inline_text;
+
+    stack = malloc(capacity * sizeof(obj_String));
+    if (stack == NULL) {
+        fprintf(stderr, "str_flatten: out of memory\n");
+        exit(1);
+    }
+    stack[top++] = s;
+    while (top > 0) {
+        piece = stack[--top];
+        if (piece->text != NULL) {
+            memcpy(out, piece->text, piece->len);
+            out += piece->len;
+            continue;
+        }
+        if (top + 2 > capacity) {
+            capacity *= 2;
+            grown = realloc(stack, capacity * sizeof(obj_String));
+            if (grown == NULL) {
+                fprintf(stderr, "str_flatten: out of memory\n");
+                exit(1);
+            }
+            stack = grown;
+        }
+        stack[top++] = piece->right;
+        stack[top++] = piece->left;
+    }
+    free(stack);
+
+    s->text  = flat->inline_text;
+    s->left  = flat;
+    s->right = NULL;
+    return s->text;
+}
+
+/* FNV-1a hash of the text, computed once. qc computes the same hash
+ * for literals when it emits them; 0 is kept for "not computed yet" */
+unsigned int str_hash(obj_String s) 
+{
+    unsigned int h = s->hash;
+    char *text;
+    int i;
+    if (h != 0) {
+        return h;
+    }
+    text = str_text(s);
+    h = 2166136261u;
+    for (i = 0; i < s->len; i++) {
+        h = (h ^ (unsigned char) text[i]) * 16777619u;
+    }
+    if (h == 0) {
+        h = 1;
+    }
+    s->hash = h;
+    return h;
+}
+
 /*****************
  * Boolean
  * Fields: 
@@ -145,28 +321,49 @@ obj_String str_literal(char *s)
 /* Boolean Constructor */
 obj_Boolean new_Boolean() 
 {
-    obj_Boolean new_thing = (obj_Boolean) malloc(sizeof(struct obj_Boolean_struct));
+    obj_Boolean new_thing = (obj_Boolean) quack_alloc(sizeof(struct obj_Boolean_struct));
     new_thing->clazz      = the_class_Boolean;
     return new_thing; 
 }
 
+/* The Strings of the builtin values are static, like literals */
+static struct obj_String_struct str_true  = { &the_class_String_struct, 4, 0, "true", NULL, NULL };
+static struct obj_String_struct str_false = { &the_class_String_struct, 5, 0, "false", NULL, NULL };
+static struct obj_String_struct str_dash  = { &the_class_String_struct, 1, 0, "-", NULL, NULL };
+static struct obj_String_struct str_nothing = { &the_class_String_struct, 9, 0, "<nothing>", NULL, NULL };
+
 /* Boolean STR method */
 obj_String Boolean_method_STR(obj_Boolean this) 
 {
     if (this == lit_true) {
-        return str_literal("true");
+        return &str_true;
+    } else if (this == lit_false) {
+        return &str_false;
+    } else {
+        return &str_dash;
+    }
+}
+
+/* Boolean PRINT method: no String in between */
+obj_Nothing Boolean_method_PRINT(obj_Boolean this) 
+{
+    if (this == lit_true) {
+        quack_out_write("true", 4);
     } else if (this == lit_false) {
-        return str_literal("false");
+        quack_out_write("false", 5);
     } else {
-        return str_literal("-");
+        quack_out_write("-", 1);
     }
+    return nothing;
 }
 
 /* The Boolean Class (a singleton) */
 struct  class_Boolean_struct  the_class_Boolean_struct = {
+    Obj_gc_map,
+    0, 0,        /* Numbered by main in the compiled program */
     new_Boolean,     /* Constructor */
     Boolean_method_STR, 
-    Obj_method_PRINT, 
+    Boolean_method_PRINT, 
     Obj_method_EQUALS
 };
 
@@ -197,14 +394,25 @@ obj_Nothing new_Nothing()
 /* Nothing STR method */
 obj_String Nothing_method_STR(obj_Nothing this) 
 {
-    return str_literal("<nothing>");
+    (void) this; /* there is only 'nothing' */
+    return &str_nothing;
+}
+
+/* Nothing PRINT method */
+obj_Nothing Nothing_method_PRINT(obj_Nothing this) 
+{
+    (void) this;
+    quack_out_write("<nothing>", 9);
+    return nothing;
 }
 
 /* The Nothing class */
 struct  class_Nothing_struct  the_class_Nothing_struct = {
+    Obj_gc_map,
+    0, 0,        /* Numbered by main in the compiled program */
     new_Nothing,     /* Constructor */
     Nothing_method_STR, 
-    Obj_method_PRINT, 
+    Nothing_method_PRINT, 
     Obj_method_EQUALS
 };
 
@@ -228,7 +436,7 @@ obj_Nothing nothing = &nothing_struct;
 /* Constructor */
 obj_Int new_Int() 
 {
-    obj_Int new_thing = (obj_Int) malloc(sizeof(struct obj_Int_struct));
+    obj_Int new_thing = (obj_Int) quack_alloc(sizeof(struct obj_Int_struct));
     new_thing->clazz  = the_class_Int;
     new_thing->value  = 0;          
     return new_thing; 
@@ -237,15 +445,25 @@ obj_Int new_Int()
 /* Int STR method */
 obj_String Int_method_STR(obj_Int this) 
 {
-    char *rep;
-    asprintf(&rep, "%d", this->value);
-    return str_literal(rep); 
+    char digits[QUACK_INT_DIGITS];
+    char *rep = quack_format_int(this->value, digits + sizeof(digits));
+    return str_new(rep, digits + sizeof(digits) - rep); 
+}
+
+/* Int PRINT method: formats the value straight into the output buffer */
+obj_Nothing Int_method_PRINT(obj_Int this) 
+{
+    quack_out_int(this->value);
+    return nothing;
 }
 
 /* Int EQUALS method */
 obj_Boolean Int_method_EQUALS(obj_Int this, obj_Obj other) 
 {
     obj_Int other_int = (obj_Int) other; 
+    if ((obj_Obj) this == other) {
+        return lit_true;    /* cached small ints are shared */
+    }
     if (other_int->clazz != this->clazz) {
         return lit_false;
     }
@@ -315,11 +533,23 @@ obj_Int Int_method_DIVIDE(obj_Int this, obj_Int other)
     return int_literal(this->value / other->value);
 }
 
+/*
+ * For internal use only!
+ * Int PRINT of an unboxed value, without boxing it first
+ */
+obj_Nothing int_print(int n) 
+{
+    quack_out_int(n);
+    return nothing;
+}
+
 /* The Int Class */ 
 struct  class_Int_struct  the_class_Int_struct = {
+    Obj_gc_map,
+    0, 0,        /* Numbered by main in the compiled program */
     new_Int,     /* Constructor */
     Int_method_STR, 
-    Obj_method_PRINT, 
+    Int_method_PRINT, 
     Int_method_EQUALS,
     Int_method_LESS,
     Int_method_MORE,
@@ -333,13 +563,25 @@ struct  class_Int_struct  the_class_Int_struct = {
 
 class_Int the_class_Int = &the_class_Int_struct; 
  
+/* Preboxed small integers, filled in the first time each one is asked for */
+static struct obj_Int_struct int_cache[QUACK_INT_CACHE_MAX - QUACK_INT_CACHE_MIN + 1];
+
 /*
  * For internal use only!
  * Function to construct an int object from a int literal
  */
 obj_Int int_literal(int n) 
 {
-    obj_Int boxed = new_Int();
+    obj_Int boxed;
+    if (n >= QUACK_INT_CACHE_MIN && n <= QUACK_INT_CACHE_MAX) {
+        boxed = &int_cache[n - QUACK_INT_CACHE_MIN];
+        if (boxed->clazz == NULL) {
+            boxed->clazz = the_class_Int;
+            boxed->value = n;
+        }
+        return boxed;
+    }
+    boxed = new_Int();
     boxed->value = n;
     return boxed;
 }
@@ -7,6 +7,8 @@
 #ifndef Builtins_h
 #define Builtins_h
 
+#include <stddef.h>
+
 
 /*
  * Forward declarations 
@@ -40,6 +42,8 @@ typedef struct obj_Obj_struct {
 } * obj_Obj;
 
 struct class_Obj_struct {
+    const size_t *gc_map;   /* Offsets of pointer fields, for quack_gc */
+    int type_pre, type_last; /* Place in the class hierarchy, for quack_instance_of */
     /* Method table */
     obj_Obj (*constructor) ( void );
     obj_String (*STR) (obj_Obj);
@@ -49,14 +53,28 @@ struct class_Obj_struct {
 
 extern class_Obj the_class_Obj; /* Initialized in Builtins.c */
 
+/* Is 'o' an instance of 'c' or of a subclass of 'c'? qc numbers the
+ * classes in preorder, so the subclasses of 'c' are numbered from
+ * type_pre to type_last. The compiled program's main sets the numbers
+ * of the builtin classes, which user classes may extend */
+static inline int quack_instance_of(obj_Obj o, class_Obj c)
+{
+    int n = o->clazz->type_pre;
+    return n >= c->type_pre && n <= c->type_last;
+}
+
 /******************
  * String
  * Fields: 
- *    One hidden field, currently holding char*
- *    (change later to a rope for garbage collection)
+ *    Hidden fields: the length and hash of the text, and the text.
+ *    A String built at run time keeps its text inline, right after
+ *    the fields, so it is a single allocation. Literals point at
+ *    their C string instead.
+ *    A String made by PLUS is a rope: it only points at its two
+ *    pieces, and its text is NULL until something needs the bytes.
+ *    Then it is flattened into a new String, kept in 'left'
  * Methods: 
  *    Those of Obj, plus ordering, concatenation 
- *    (Incomplete for now.)
  ********************
  */
 
@@ -65,21 +83,47 @@ typedef struct class_String_struct* class_String;
 
 typedef struct obj_String_struct {
     class_String clazz;
-    char *text;
+    int len;            /* bytes of text, not counting the closing NUL */
+    unsigned int hash;  /* 0 until str_hash computes it */
+    char *text;         /* inline_text, a C literal, the text of 'left', or NULL */
+    struct obj_String_struct *left;     /* pieces of a rope */
+    struct obj_String_struct *right;
+    char inline_text[];
 } * obj_String;
 
 struct class_String_struct {
+    const size_t *gc_map;   /* Offsets of pointer fields, for quack_gc */
+    int type_pre, type_last; /* Place in the class hierarchy, for quack_instance_of */
     /* Method table: Inherited or overridden */
     obj_String (*constructor) ( void );
     obj_String (*STR) (obj_String);
     obj_Nothing (*PRINT) (obj_String);
     obj_Boolean (*EQUALS) (obj_String, obj_Obj);
     /* Method table: Introduced in String */
+    obj_String (*PLUS) (obj_String, obj_String);
+    obj_Boolean (*ATMOST) (obj_String, obj_String);
     obj_Boolean (*LESS) (obj_String, obj_String); 
+    obj_Boolean (*ATLEAST) (obj_String, obj_String);
+    obj_Boolean (*MORE) (obj_String, obj_String);
 };
 
 extern class_String the_class_String;
+extern struct class_String_struct the_class_String_struct; /* For static literals */
 extern obj_String str_literal(char *s);
+extern obj_String str_new(const char *s, int len);
+extern unsigned int str_hash(obj_String s);
+extern char *str_flatten(obj_String s);
+
+/* The bytes of 's', flattening it first if it is a rope */
+static inline char *str_text(obj_String s)
+{
+    return s->text != NULL ? s->text : str_flatten(s);
+}
+
+/* Concatenations shorter than this are copied instead of making a rope */
+#ifndef QUACK_ROPE_MIN
+#define QUACK_ROPE_MIN 32
+#endif
 
 /******************
  * Boolean
@@ -99,10 +143,12 @@ typedef struct obj_Boolean_struct {
 } * obj_Boolean;
 
 struct class_Boolean_struct {
+    const size_t *gc_map;   /* Offsets of pointer fields, for quack_gc */
+    int type_pre, type_last; /* Place in the class hierarchy, for quack_instance_of */
     /* Method table: Inherited or overridden */
     obj_Boolean (*constructor) ( void );
     obj_String (*STR) (obj_Boolean);
-    obj_Nothing (*PRINT) (obj_Obj);               /* Inherit */
+    obj_Nothing (*PRINT) (obj_Boolean);
     obj_Boolean (*EQUALS) (obj_Obj, obj_Obj); /* Inherit */ 
 };
 
@@ -135,10 +181,12 @@ typedef struct obj_Nothing_struct {
 } * obj_Nothing;
 
 struct class_Nothing_struct {
+    const size_t *gc_map;   /* Offsets of pointer fields, for quack_gc */
+    int type_pre, type_last; /* Place in the class hierarchy, for quack_instance_of */
     /* Method table */
     obj_Nothing (*constructor) ();
     obj_String (*STR) (obj_Nothing);
-    obj_Nothing (*PRINT) (obj_Obj);               /* Inherited */
+    obj_Nothing (*PRINT) (obj_Nothing);
     obj_Boolean (*EQUALS) (obj_Obj, obj_Obj); /* Inherited */
 }; 
 
@@ -151,7 +199,7 @@ extern obj_Nothing nothing;
  *    One hidden field, an int
  * Methods: 
  *    STRING  (override)
- *    PRINT   (inherit)
+ *    PRINT   (override)
  *    EQUALS  (override)
  *    and introducing
  *    LESS
@@ -169,10 +217,12 @@ typedef struct obj_Int_struct {
 } * obj_Int;
 
 struct class_Int_struct {
+    const size_t *gc_map;   /* Offsets of pointer fields, for quack_gc */
+    int type_pre, type_last; /* Place in the class hierarchy, for quack_instance_of */
     /* Method table: Inherited or overridden */
     obj_Int (*constructor) ( void );
     obj_String (*STR) (obj_Int);  /* Overridden */
-    obj_Nothing (*PRINT) (obj_Obj);      /* Inherited */
+    obj_Nothing (*PRINT) (obj_Int);      /* Overridden */
     obj_Boolean (*EQUALS) (obj_Int, obj_Obj); /* Overridden */
     obj_Boolean (*LESS) (obj_Int, obj_Int);   /* Introduced */
     obj_Boolean (*MORE) (obj_Int, obj_Int);   /* Introduced */
@@ -185,9 +235,20 @@ struct class_Int_struct {
 };
 
 extern class_Int the_class_Int; 
+extern struct class_Int_struct the_class_Int_struct; /* For static literals */
 
-/* Integer literals constructor */
+/* Integer literals constructor 
+ * Values in [QUACK_INT_CACHE_MIN, QUACK_INT_CACHE_MAX] are not allocated;
+ * every call returns the same preboxed instance from a static table.
+ */
+#ifndef QUACK_INT_CACHE_MIN
+#define QUACK_INT_CACHE_MIN (-1024)
+#endif
+#ifndef QUACK_INT_CACHE_MAX
+#define QUACK_INT_CACHE_MAX 65535
+#endif
 extern obj_Int int_literal(int n);
+extern obj_Nothing int_print(int n);
 
 
 /*********************************
@@ -202,9 +263,17 @@ obj_Boolean Obj_method_EQUALS(obj_Obj this, obj_Obj other);
 obj_String String_method_STR(obj_String this);
 obj_Nothing String_method_PRINT(obj_String this); 
 obj_Boolean String_method_EQUALS(obj_String this, obj_Obj other); 
+obj_String String_method_PLUS(obj_String this, obj_String other);
+obj_Boolean String_method_ATMOST(obj_String this, obj_String other);
+obj_Boolean String_method_LESS(obj_String this, obj_String other);
+obj_Boolean String_method_ATLEAST(obj_String this, obj_String other);
+obj_Boolean String_method_MORE(obj_String this, obj_String other);
 obj_String Boolean_method_STR(obj_Boolean this); 
+obj_Nothing Boolean_method_PRINT(obj_Boolean this); 
 obj_String Nothing_method_STR(obj_Nothing this);
+obj_Nothing Nothing_method_PRINT(obj_Nothing this); 
 obj_String Int_method_STR(obj_Int this); 
+obj_Nothing Int_method_PRINT(obj_Int this); 
 obj_Boolean Int_method_EQUALS(obj_Int this, obj_Obj other);
 obj_Boolean Int_method_LESS(obj_Int this, obj_Int other);
 obj_Boolean Int_method_MORE(obj_Int this, obj_Int other);
@@ -0,0 +1,267 @@
+/*
+ * Implementation of the control flow graph and of TypeFlow
+ *
+ * */
+#include <algorithm>
+#include <list>
+
+#include <stdlib.h>
+
+#include "CFG.hpp"
+#include "util.hpp"
+
+using std::list;
+
+CFGNode::CFGNode(Kind k, Statement *s, RExpr *c, int i) : kind(k), stmt(s), cond(c), index(i) {}
+
+CFG::CFG(NodeList<Statement *> *stmts)
+{
+    entry = add(CFGNode::ENTRY, NULL, NULL);
+    exit = new CFGNode(CFGNode::EXIT, NULL, NULL, -1); // numbered last
+    CFGNode *end = build(stmts, entry);
+    exit->index = nodes.size();
+    nodes.push_back(exit);
+    edge(end, exit);
+}
+
+CFG::~CFG()
+{
+    for (vector<CFGNode *>::const_iterator it = nodes.begin(); it != nodes.end(); ++it)
+    {
+        delete *it;
+    }
+}
+
+CFGNode *CFG::add(CFGNode::Kind k, Statement *s, RExpr *c)
+{
+    CFGNode *node = new CFGNode(k, s, c, nodes.size());
+    nodes.push_back(node);
+    return node;
+}
+
+void CFG::edge(CFGNode *from, CFGNode *to)
+{
+    if (from == NULL) // nothing runs after a return
+        return;
+    from->succs.push_back(to);
+    to->preds.push_back(from);
+}
+
+CFGNode *CFG::build(NodeList<Statement *> *stmts, CFGNode *from)
+{
+    for (NodeList<Statement *>::const_iterator it = stmts->begin(); it != stmts->end(); ++it)
+    {
+        WhileStatement *w = dynamic_cast<WhileStatement*>(*it);
+        IfBlock *i = dynamic_cast<IfBlock*>(*it);
+        if (w != NULL)
+        {
+            CFGNode *header = add(CFGNode::LOOP, w, w->rexpr);
+            edge(from, header);
+            edge(build(w->stmts, header), header);
+            from = header; // the loop is left when the condition fails
+        }
+        else if (i != NULL)
+        {
+            list<CFGNode *> ends;
+            CFGNode *test = add(CFGNode::BRANCH, i, i->_if->rexpr);
+            edge(from, test);
+            ends.push_back(build(i->_if->stmts, test));
+            for (NodeList<ElifClause *>::const_iterator e = i->_elifs->begin(); e != i->_elifs->end(); ++e)
+            {
+                CFGNode *next = add(CFGNode::BRANCH, i, (*e)->rexpr);
+                edge(test, next);
+                ends.push_back(build((*e)->stmts, next));
+                test = next;
+            }
+            TrueElseOption *tso = dynamic_cast<TrueElseOption*>(i->_else);
+            if (tso != NULL)
+                ends.push_back(build(tso->stmts, test));
+            else
+                ends.push_back(test);
+            CFGNode *join = add(CFGNode::JOIN, i, NULL);
+            for (list<CFGNode *>::const_iterator e = ends.begin(); e != ends.end(); ++e)
+            {
+                edge(*e, join);
+            }
+            from = join->preds.empty() ? NULL : join;
+        }
+        else
+        {
+            if (from == NULL || from->kind != CFGNode::BLOCK || !from->succs.empty())
+            {
+                CFGNode *n = add(CFGNode::BLOCK, NULL, NULL);
+                edge(from, n);
+                from = n;
+            }
+            from->stmts.push_back(*it);
+            if (dynamic_cast<ReturnStatement*>(*it) != NULL)
+            {
+                edge(from, exit);
+                from = NULL;
+            }
+        }
+    }
+    return from;
+}
+
+
+/*********************
+ *
+ * Defining TypeFlow methods
+ *
+ ***********************/
+
+TypeFlow::TypeFlow(TypeTree *t, SymbolTable *o, char *c) : tt(t), outer(o), className(c) {}
+
+/* Loop headers join every variable from either side, and keep what
+ * reached them before, so the facts there only grow. Other nodes keep
+ * the variables every predecessor knows, or that were known before the
+ * body. Facts are sorted by name, so this merges them */
+void TypeFlow::meet(CFGNode *n, vector<const Fact *> &preds, Fact &in)
+{
+    bool loop = n->kind == CFGNode::LOOP;
+    if (!loop)
+        in = preds.empty() ? Fact() : *preds[0];
+    Fact joined;
+    for (size_t k = loop ? 0 : 1; k < preds.size(); k++)
+    {
+        const Fact &p = *preds[k];
+        joined.clear();
+        size_t i = 0, j = 0;
+        while (i < in.size() || j < p.size())
+        {
+            if (j == p.size() || (i < in.size() && in[i].first < p[j].first))
+                keep(in[i++], loop, joined);
+            else if (i == in.size() || p[j].first < in[i].first)
+                keep(p[j++], loop, joined);
+            else
+            {
+                char *type = in[i].second;
+                if (type != p[j].second)
+                {
+                    char *lca = tt->LCA(type, p[j].second);
+                    if (lca != NULL)
+                        type = lca;
+                }
+                joined.push_back(Fact::value_type(in[i].first, type));
+                i++;
+                j++;
+            }
+        }
+        in.swap(joined);
+    }
+}
+
+// 'v' reached 'n' from one side only: the other side still has the type
+// it had before the body, if any
+void TypeFlow::keep(const Fact::value_type &v, bool loop, Fact &joined)
+{
+    VariableSym *before = outer->lookupVariable(v.first);
+    if (before == NULL)
+    {
+        if (loop)
+            joined.push_back(v);
+        return;
+    }
+    char *lca = tt->LCA(before->type, v.second);
+    joined.push_back(Fact::value_type(v.first, lca != NULL ? lca : v.second));
+}
+
+void TypeFlow::transfer(CFGNode *n, Fact &f)
+{
+    for (vector<Statement *>::const_iterator it = n->stmts.begin(); it != n->stmts.end(); ++it)
+    {
+        AssignmentStatement *a = dynamic_cast<AssignmentStatement*>(*it);
+        if (a != NULL)
+            assign(a, f);
+    }
+}
+
+// Only an assignment to a variable changes the fact, as in
+// TypeCheckVisitor::visitAssignmentStatement
+void TypeFlow::assign(AssignmentStatement *a, Fact &f)
+{
+    IdentNode *id = dynamic_cast<IdentNode*>(a->lexpr);
+    if (id == NULL)
+        return;
+
+    char *type = typeOf(a->rexpr, f);
+    char *defined = lookup(f, id->id);
+    TrueIdentOption *tio = dynamic_cast<TrueIdentOption*>(a->ident);
+    if (tio != NULL && defined != NULL)
+    {
+        type = tt->LCA(defined, tt->LCA(tio->id, type));
+    }
+    else if (defined != NULL)
+    {
+        type = tt->LCA(defined, type);
+        if (type == NULL)
+            type = defined;
+    }
+    else if (tio != NULL)
+    {
+        type = tt->LCA(tio->id, type);
+    }
+    if (type == NULL)
+        return;
+    Fact::iterator it = find(f, id->id);
+    if (it != f.end() && it->first == id->id)
+        it->second = type;
+    else
+        f.insert(it, Fact::value_type(id->id, type));
+}
+
+// Where 'name' is in 'f', or would go
+TypeFlow::Fact::iterator TypeFlow::find(Fact &f, char *name)
+{
+    return std::lower_bound(f.begin(), f.end(), Fact::value_type(name, (char *) NULL), byName);
+}
+
+bool TypeFlow::byName(const Fact::value_type &a, const Fact::value_type &b)
+{
+    return a.first < b.first;
+}
+
+char *TypeFlow::lookup(Fact &f, char *name)
+{
+    Fact::iterator it = find(f, name);
+    if (it != f.end() && it->first == name)
+        return it->second;
+    VariableSym *v = outer->lookupVariable(name);
+    return v != NULL ? v->type : NULL;
+}
+
+// The type of 'r' as TypeCheckVisitor::getType works it out, or NULL
+char *TypeFlow::typeOf(RExpr *r, Fact &f)
+{
+    char *type = r->type();
+    if (type != NAME_UNKNOWN)
+        return type;
+
+    RExprToLExpr *rl = dynamic_cast<RExprToLExpr*>(r);
+    IdentNode *ident = rl != NULL ? dynamic_cast<IdentNode*>(rl->lexpr) : NULL;
+    ObjectFieldLExpr *ofl = rl != NULL ? dynamic_cast<ObjectFieldLExpr*>(rl->lexpr) : NULL;
+    if (ident != NULL)
+    {
+        if (ident->id == NAME_THIS)
+            return className;
+        return lookup(f, ident->id);
+    }
+    if (ofl != NULL)
+    {
+        char *rType = typeOf(ofl->rexpr, f);
+        return rType != NULL ? tt->getVarFromType(rType, ofl->id) : NULL;
+    }
+    DotRExpr *dot = dynamic_cast<DotRExpr*>(r);
+    if (dot != NULL)
+    {
+        MethodNode *m = tt->typeGetMethod(typeOf(dot->rexpr, f), dot->id);
+        return m != NULL ? m->returnType : NULL;
+    }
+    if (dynamic_cast<PlusNode*>(r) != NULL || dynamic_cast<MinusNode*>(r) != NULL
+        || dynamic_cast<TimesNode*>(r) != NULL || dynamic_cast<DivideNode*>(r) != NULL)
+    {
+        return typeOf(((BinaryOperatorNode*) r)->left, f);
+    }
+    return NULL;
+}
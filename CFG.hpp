@@ -0,0 +1,140 @@
+/*
+ * CFG.hpp defines a control flow graph over the statements of a body
+ * (the main program, a constructor or a method), a worklist solver for
+ * forward dataflow problems on it, and TypeFlow, the type inference the
+ * TypeCheckVisitor runs on loops.
+ *
+ * The graph has a node per basic block (a run of assignments and
+ * expression statements, possibly ended by a return), one per condition
+ * of an if/elif, one per loop header, and a join node after each if.
+ * Edges go from a node to the next ones that may run.
+ *
+ * */
+#ifndef CFG_H
+#define CFG_H
+
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "nodes.hpp"
+#include "SymbolTable.hpp"
+#include "TypeTree.hpp"
+
+using std::pair;
+using std::set;
+using std::vector;
+
+class CFGNode
+{
+    public:
+        enum Kind { ENTRY, EXIT, BLOCK, BRANCH, LOOP, JOIN };
+
+        Kind kind;
+        Statement *stmt; // the while of a LOOP, the if block of a BRANCH or JOIN
+        vector<Statement *> stmts; // the statements of a BLOCK, in order
+        RExpr *cond; // the condition tested by a BRANCH or LOOP
+        int index; // position in CFG::nodes
+        vector<CFGNode *> succs;
+        vector<CFGNode *> preds;
+
+        CFGNode(Kind k, Statement *s, RExpr *c, int i);
+};
+
+class CFG
+{
+    public:
+        vector<CFGNode *> nodes; // in the order they were built: a node comes before
+                                 // its successors, except along the edge back to a loop
+        CFGNode *entry;
+        CFGNode *exit;
+
+        CFG(NodeList<Statement *> *stmts);
+        ~CFG();
+
+    private:
+        CFGNode *add(CFGNode::Kind k, Statement *s, RExpr *c);
+        void edge(CFGNode *from, CFGNode *to);
+        // Add the nodes of 'stmts', run after 'from'. Returns the node the
+        // statements end in, or NULL if they always return
+        CFGNode *build(NodeList<Statement *> *stmts, CFGNode *from);
+};
+
+/* Solve a forward dataflow problem on 'cfg'. The analysis 'a' supplies
+ *   typedef ... Fact;   a value with ==, the default one being empty
+ *   void meet(CFGNode *n, vector<const Fact *> &preds, Fact &in);
+ *        combine the facts leaving the predecessors of 'n' reached so far
+ *        into 'in', which holds what reached 'n' last time
+ *   void transfer(CFGNode *n, Fact &f);
+ *        turn the fact on entry to 'n' into the fact leaving it
+ * Nodes wait in a worklist ordered by index, so a loop body is done
+ * before what follows the loop. Once nothing changes, in[i] is the fact
+ * on entry to cfg->nodes[i]. The analysis must make every fact entering
+ * a LOOP node grow, so the solver stops */
+template <class A>
+void forwardDataflow(CFG *cfg, A &a, vector<typename A::Fact> &in)
+{
+    typedef typename A::Fact Fact;
+    size_t count = cfg->nodes.size();
+    vector<Fact> out(count);
+    vector<bool> reached(count, false);
+    in.assign(count, Fact());
+
+    set<int> work;
+    work.insert(cfg->entry->index);
+    while (!work.empty())
+    {
+        CFGNode *n = cfg->nodes[*work.begin()];
+        work.erase(work.begin());
+
+        vector<const Fact *> preds;
+        for (vector<CFGNode *>::const_iterator it = n->preds.begin(); it != n->preds.end(); ++it)
+        {
+            if (reached[(*it)->index])
+                preds.push_back(&out[(*it)->index]);
+        }
+        a.meet(n, preds, in[n->index]);
+        Fact f = in[n->index];
+        a.transfer(n, f);
+        if (reached[n->index] && f == out[n->index])
+            continue;
+        reached[n->index] = true;
+        out[n->index] = f;
+        for (vector<CFGNode *>::const_iterator it = n->succs.begin(); it != n->succs.end(); ++it)
+        {
+            work.insert((*it)->index);
+        }
+    }
+}
+
+/* TypeFlow infers the type of every variable assigned in a body, the
+ * way the TypeCheckVisitor does: a variable's type is the LCA of the
+ * types assigned to it. After an if, a variable is known if every branch
+ * knows it or it was known before the body; at a loop header, the types coming around the loop are
+ * joined with the ones from before it, so the fact there is the type
+ * each variable has on every iteration. Names not in a fact are looked
+ * up in 'outer', the scope the body starts in
+ * */
+class TypeFlow
+{
+    public:
+        typedef vector<pair<char *, char *> > Fact; // (variable name, type), sorted by name
+
+        TypeFlow(TypeTree *t, SymbolTable *outer, char *className);
+        void meet(CFGNode *n, vector<const Fact *> &preds, Fact &in);
+        void transfer(CFGNode *n, Fact &f);
+
+    private:
+        TypeTree *tt;
+        SymbolTable *outer;
+        char *className;
+
+        void keep(const Fact::value_type &v, bool loop, Fact &joined);
+        void assign(AssignmentStatement *a, Fact &f);
+        char *lookup(Fact &f, char *name);
+        static Fact::iterator find(Fact &f, char *name);
+        static bool byName(const Fact::value_type &a, const Fact::value_type &b);
+        char *typeOf(RExpr *r, Fact &f);
+};
+
+#endif
@@ -0,0 +1,425 @@
+/*
+ * Implementation of the ConstantFoldVisitor
+ *
+ * */
+
+#include <vector>
+
+#include <ctype.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "util.hpp"
+#include "ConstantFoldVisitor.hpp"
+
+using std::vector;
+
+/* Counts the assignments to each local of a body, at any depth */
+class AssignmentCounter : public Visitor
+{
+    public:
+        unordered_map<char *, int> *counts;
+
+        virtual void visitAssignmentStatement(AssignmentStatement *a)
+        {
+            IdentNode *id = dynamic_cast<IdentNode*>(a->lexpr);
+            if (id != NULL)
+                (*counts)[id->id]++;
+        }
+};
+
+
+/*********************
+ *
+ * Defining ConstantFoldVisitor methods
+ *
+ ***********************/
+
+ConstantFoldVisitor::ConstantFoldVisitor()
+{
+    folded = NULL;
+    removed = false;
+    depth = 0;
+    folds = 0;
+    branches = 0;
+}
+
+void ConstantFoldVisitor::visitProgram(Program *p)
+{
+    for (NodeList<Class *>::const_iterator it = p->classes->begin(); it != p->classes->end(); ++it)
+    {
+        (*it)->accept(this);
+    }
+    foldBody(NULL, p->statements);
+}
+
+// The constructor is the class body, with the class's arguments
+void ConstantFoldVisitor::visitClass(Class *c)
+{
+    foldBody(c->clssig->fargs, c->clsbdy->stmts);
+    for (NodeList<Method *>::const_iterator it = c->clsbdy->meths->begin(); it != c->clsbdy->meths->end(); ++it)
+    {
+        (*it)->accept(this);
+    }
+}
+
+void ConstantFoldVisitor::visitMethod(Method *m)
+{
+    foldBody(m->fargs, m->stmts);
+}
+
+void ConstantFoldVisitor::visitAssignmentStatement(AssignmentStatement *a)
+{
+    fold(a->rexpr);
+    a->lexpr->accept(this);
+    IdentNode *id = dynamic_cast<IdentNode*>(a->lexpr);
+    if (id == NULL || depth > 0 || assignments[id->id] != 1)
+        return;
+    // Without a declared type, the local has the type of its one value
+    if (dynamic_cast<FalseIdentOption*>(a->ident) == NULL)
+        return;
+    if (dynamic_cast<IntNode*>(a->rexpr) != NULL || dynamic_cast<StringNode*>(a->rexpr) != NULL
+        || isBoolean(a->rexpr) >= 0)
+    {
+        constants[id->id] = a->rexpr;
+    }
+}
+
+void ConstantFoldVisitor::visitReturnStatement(ReturnStatement *r)
+{
+    fold(r->rexpr);
+}
+
+void ConstantFoldVisitor::visitRExprStatement(RExprStatement *r)
+{
+    fold(r->rexpr);
+}
+
+void ConstantFoldVisitor::visitWhileStatement(WhileStatement *w)
+{
+    fold(w->rexpr);
+    depth++;
+    foldBlock(w->stmts);
+    depth--;
+}
+
+/* Fold the conditions and branches, then keep the branches that may run:
+ * not those whose condition is false, and none after one whose condition
+ * is true. An if left with no branch is removed */
+void ConstantFoldVisitor::visitIfBlock(IfBlock *i)
+{
+    depth++;
+    fold(i->_if->rexpr);
+    foldBlock(i->_if->stmts);
+    for (NodeList<ElifClause *>::const_iterator it = i->_elifs->begin(); it != i->_elifs->end(); ++it)
+    {
+        fold((*it)->rexpr);
+        foldBlock((*it)->stmts);
+    }
+    TrueElseOption *tso = dynamic_cast<TrueElseOption*>(i->_else);
+    if (tso != NULL)
+        foldBlock(tso->stmts);
+    depth--;
+    removed = false;
+
+    // The branches in order; the else has no condition
+    vector<Node *> clauses;
+    vector<RExpr *> conds;
+    vector<NodeList<Statement *> *> bodies;
+    clauses.push_back(i->_if);
+    conds.push_back(i->_if->rexpr);
+    bodies.push_back(i->_if->stmts);
+    for (NodeList<ElifClause *>::const_iterator it = i->_elifs->begin(); it != i->_elifs->end(); ++it)
+    {
+        clauses.push_back(*it);
+        conds.push_back((*it)->rexpr);
+        bodies.push_back((*it)->stmts);
+    }
+    if (tso != NULL)
+    {
+        clauses.push_back(tso);
+        conds.push_back(NULL);
+        bodies.push_back(tso->stmts);
+    }
+
+    vector<int> kept;
+    bool last = false; // the last branch kept always runs when reached
+    for (int k = 0; k < (int) clauses.size() && !last; k++)
+    {
+        int known = conds[k] != NULL ? isBoolean(conds[k]) : 1;
+        if (known == 0)
+            continue;
+        kept.push_back(k);
+        last = known == 1;
+    }
+    if (kept.size() == clauses.size())
+        return;
+    branches += clauses.size() - kept.size();
+    if (kept.empty())
+    {
+        removed = true;
+        return;
+    }
+
+    Node *first = clauses[kept[0]];
+    IfClause *ic = new IfClause(conds[kept[0]] != NULL ? conds[kept[0]] : boolean(true, i->_if->rexpr), bodies[kept[0]]);
+    ic->setLineno(first->lineno);
+    ic->st = first->st;
+    NodeList<ElifClause *> *elifs = new NodeList<ElifClause *>();
+    ElseOption *els = new FalseElseOption();
+    els->st = NULL;
+    for (int k = 1; k < (int) kept.size(); k++)
+    {
+        Node *clause = clauses[kept[k]];
+        if (last && k == (int) kept.size() - 1) // runs whenever the ones before fail
+        {
+            els = new TrueElseOption(bodies[kept[k]]);
+            els->setLineno(clause->lineno);
+            els->st = clause->st;
+            break;
+        }
+        ElifClause *ec = new ElifClause(conds[kept[k]], bodies[kept[k]]);
+        ec->setLineno(clause->lineno);
+        ec->st = clause->st;
+        elifs->push_back(ec);
+    }
+    i->_if = ic;
+    i->_elifs = elifs;
+    i->_else = els;
+}
+
+void ConstantFoldVisitor::visitDotRExpr(DotRExpr *d)
+{
+    fold(d->rexpr);
+    for (NodeList<RExpr *>::iterator it = d->args->begin(); it != d->args->end(); ++it)
+    {
+        fold(*it);
+    }
+    folded = d;
+}
+
+void ConstantFoldVisitor::visitConstructorRExpr(ConstructorRExpr *c)
+{
+    for (NodeList<RExpr *>::iterator it = c->args->begin(); it != c->args->end(); ++it)
+    {
+        fold(*it);
+    }
+    folded = c;
+}
+
+// A local holding a literal is replaced by a copy of the literal
+void ConstantFoldVisitor::visitRExprToLExpr(RExprToLExpr *rl)
+{
+    IdentNode *id = dynamic_cast<IdentNode*>(rl->lexpr);
+    if (id != NULL)
+    {
+        auto c = constants.find(id->id);
+        if (c != constants.end())
+        {
+            folded = copy(c->second, rl);
+            folds++;
+            return;
+        }
+    }
+    rl->lexpr->accept(this);
+    folded = rl;
+}
+
+void ConstantFoldVisitor::visitNotNode(NotNode *n)
+{
+    fold(n->value);
+    int known = isBoolean(n->value);
+    if (known >= 0)
+    {
+        folded = boolean(known == 0, n);
+        folds++;
+        return;
+    }
+    folded = n;
+}
+
+void ConstantFoldVisitor::visitBinaryOperatorNode(BinaryOperatorNode *b)
+{
+    fold(b->left);
+    fold(b->right);
+    folded = foldOperator(b);
+    if (folded != b)
+        folds++;
+}
+
+void ConstantFoldVisitor::visitObjectFieldLExpr(ObjectFieldLExpr *o)
+{
+    fold(o->rexpr);
+}
+
+
+/*********************
+ *
+ * ConstantFoldVisitor private methods
+ *
+ ***********************/
+
+// Fold 'r' and put what replaces it in its place
+void ConstantFoldVisitor::fold(RExpr *&r)
+{
+    folded = r; // leaves have nothing to fold
+    r->accept(this);
+    r = folded;
+}
+
+// A body of statements with locals of its own, whose arguments 'args'
+// are assigned on entry
+void ConstantFoldVisitor::foldBody(NodeList<FormalArg *> *args, NodeList<Statement *> *stmts)
+{
+    assignments.clear();
+    constants.clear();
+    if (args != NULL)
+    {
+        for (NodeList<FormalArg *>::const_iterator it = args->begin(); it != args->end(); ++it)
+        {
+            assignments[(*it)->id]++;
+        }
+    }
+    AssignmentCounter counter;
+    counter.counts = &assignments;
+    for (NodeList<Statement *>::const_iterator it = stmts->begin(); it != stmts->end(); ++it)
+    {
+        (*it)->accept(&counter);
+    }
+    depth = 0;
+    foldBlock(stmts);
+    assignments.clear();
+    constants.clear();
+}
+
+void ConstantFoldVisitor::foldBlock(NodeList<Statement *> *stmts)
+{
+    for (NodeList<Statement *>::iterator it = stmts->begin(); it != stmts->end(); )
+    {
+        removed = false;
+        (*it)->accept(this);
+        if (removed)
+            it = stmts->erase(it);
+        else
+            ++it;
+    }
+    removed = false;
+}
+
+// The literal true or false, in place of 'at'
+RExpr *ConstantFoldVisitor::boolean(bool value, RExpr *at)
+{
+    IdentNode *id = new IdentNode(value ? NAME_TRUE : NAME_FALSE);
+    id->setLineno(at->lineno);
+    RExpr *r = new RExprToLExpr(id);
+    r->setLineno(at->lineno);
+    r->resolvedType = NAME_BOOLEAN;
+    return r;
+}
+
+// The Int literal 'value' in place of 'at', or 'at' if an Int cannot hold it
+RExpr *ConstantFoldVisitor::integer(long value, RExpr *at)
+{
+    if (value > INT_MAX || value < -INT_MAX)
+        return at;
+    RExpr *r = new IntNode((int) value);
+    r->setLineno(at->lineno);
+    r->resolvedType = NAME_INT;
+    return r;
+}
+
+// A copy of the literal 'r', in place of 'at'
+RExpr *ConstantFoldVisitor::copy(RExpr *r, RExpr *at)
+{
+    IntNode *i = dynamic_cast<IntNode*>(r);
+    StringNode *s = dynamic_cast<StringNode*>(r);
+    if (i != NULL)
+        return integer(i->value, at);
+    if (s != NULL)
+    {
+        RExpr *str = new StringNode(s->id);
+        str->setLineno(at->lineno);
+        str->resolvedType = NAME_STRING;
+        return str;
+    }
+    return boolean(isBoolean(r) == 1, at);
+}
+
+// 1 if 'r' is the literal true, 0 if it is false, -1 otherwise
+int ConstantFoldVisitor::isBoolean(RExpr *r)
+{
+    RExprToLExpr *rl = dynamic_cast<RExprToLExpr*>(r);
+    IdentNode *id = rl != NULL ? dynamic_cast<IdentNode*>(rl->lexpr) : NULL;
+    if (id != NULL && id->id == NAME_TRUE)
+        return 1;
+    if (id != NULL && id->id == NAME_FALSE)
+        return 0;
+    return -1;
+}
+
+// 'b', whose operands are folded already, or the simpler expression it
+// amounts to
+RExpr *ConstantFoldVisitor::foldOperator(BinaryOperatorNode *b)
+{
+    IntNode *li = dynamic_cast<IntNode*>(b->left);
+    IntNode *ri = dynamic_cast<IntNode*>(b->right);
+    if (li != NULL && ri != NULL)
+    {
+        long l = li->value;
+        long r = ri->value;
+        switch (b->operation)
+        {
+            case 0: return integer(l + r, b);
+            case 1: return integer(l - r, b);
+            case 2: return integer(l * r, b);
+            case 3: return r != 0 ? integer(l / r, b) : b; // dividing by 0 is left to run time
+            case 4: return boolean(l == r, b);
+            case 5: return boolean(l <= r, b);
+            case 6: return boolean(l < r, b);
+            case 7: return boolean(l >= r, b);
+            case 8: return boolean(l > r, b);
+        }
+        return b;
+    }
+
+    int lb = isBoolean(b->left);
+    int rb = isBoolean(b->right);
+    if (b->operation == 4 && lb >= 0 && rb >= 0)
+        return boolean(lb == rb, b);
+    if (b->operation == 9 || b->operation == 10)
+    {
+        bool isAnd = b->operation == 9;
+        if (lb >= 0) // the right side runs only if the left does not decide
+            return (lb == 1) == isAnd ? b->right : b->left;
+        if (rb == (isAnd ? 1 : 0)) // x and true, x or false
+            return b->left;
+        return b;
+    }
+
+    StringNode *ls = dynamic_cast<StringNode*>(b->left);
+    StringNode *rs = dynamic_cast<StringNode*>(b->right);
+    if (b->operation == 0 && ls != NULL && rs != NULL)
+        return foldStrings(ls, rs, b);
+    return b;
+}
+
+/* The literal that reads as 'left' then 'right'. The quotes between them
+ * are dropped and the escapes copied as they are, unless that would run
+ * a \0 into a digit. Triple quoted literals are left alone */
+RExpr *ConstantFoldVisitor::foldStrings(StringNode *left, StringNode *right, RExpr *at)
+{
+    size_t ll = strlen(left->id);
+    size_t rl = strlen(right->id);
+    if (strncmp(left->id, "\"\"\"", 3) == 0 || strncmp(right->id, "\"\"\"", 3) == 0)
+        return at;
+    if (ll >= 3 && left->id[ll - 3] == '\\' && left->id[ll - 2] == '0' && rl >= 2 && isdigit(right->id[1]))
+        return at;
+    char *text = (char*) malloc(ll + rl - 1);
+    memcpy(text, left->id, ll - 1);
+    memcpy(text + ll - 1, right->id + 1, rl); // with the terminating 0
+    RExpr *s = new StringNode(text);
+    s->setLineno(at->lineno);
+    s->resolvedType = NAME_STRING;
+    return s;
+}
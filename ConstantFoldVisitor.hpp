@@ -0,0 +1,71 @@
+/*
+ * The ConstantFoldVisitor runs between type checking and code generation.
+ * It works out the expressions whose operands are literals, so
+ * '60 * 60 * 24' or '"a" + "b"' reach the TranslatorVisitor as one literal:
+ *   - Int arithmetic and comparisons, and == on Booleans
+ *   - and, or and not once their left side is known
+ *   - + on two String literals
+ * A local assigned once, at the top level of its body and without a
+ * declared type, is replaced by its value wherever it is read after the
+ * assignment when that value is a literal. The branches of an if whose
+ * condition is known false are dropped, and so is everything after a
+ * branch known true.
+ *
+ * Folded nodes carry the resolved type and line of what they replace.
+ * */
+
+#ifndef CONSTANTFOLDVISITOR_H
+#define CONSTANTFOLDVISITOR_H
+
+#include <unordered_map>
+
+#include "visitors.hpp"
+
+using std::unordered_map;
+
+class ConstantFoldVisitor : public Visitor
+{
+    private:
+        RExpr *folded; // what the RExpr visited last is replaced by
+        bool removed;  // the statement visited last is gone
+        int depth;     // of the statement being visited, 0 at the top of a body
+
+        // Locals of the body being visited: how often each is assigned,
+        // and the literal held by those assigned once so far
+        unordered_map<char *, int> assignments;
+        unordered_map<char *, RExpr *> constants;
+
+        void fold(RExpr *&r);
+        void foldBody(NodeList<FormalArg *> *args, NodeList<Statement *> *stmts);
+        void foldBlock(NodeList<Statement *> *stmts);
+
+        RExpr *boolean(bool value, RExpr *at);
+        RExpr *integer(long value, RExpr *at);
+        RExpr *copy(RExpr *r, RExpr *at);
+        int isBoolean(RExpr *r);
+        RExpr *foldOperator(BinaryOperatorNode *b);
+        RExpr *foldStrings(StringNode *left, StringNode *right, RExpr *at);
+
+    public:
+        int folds;    // expressions replaced by a literal
+        int branches; // if/elif/else branches dropped
+
+        ConstantFoldVisitor();
+
+        void visitProgram(Program *);
+        void visitClass(Class *);
+        void visitMethod(Method *);
+        void visitAssignmentStatement(AssignmentStatement *);
+        void visitReturnStatement(ReturnStatement *);
+        void visitRExprStatement(RExprStatement *);
+        void visitWhileStatement(WhileStatement *);
+        void visitIfBlock(IfBlock *);
+        void visitDotRExpr(DotRExpr *);
+        void visitConstructorRExpr(ConstructorRExpr *);
+        void visitRExprToLExpr(RExprToLExpr *);
+        void visitNotNode(NotNode *);
+        void visitBinaryOperatorNode(BinaryOperatorNode *);
+        void visitObjectFieldLExpr(ObjectFieldLExpr *);
+};
+
+#endif
@@ -0,0 +1,236 @@
+/*
+ * Implementation of the EscapeVisitor
+ *
+ * */
+
+#include "util.hpp"
+#include "EscapeVisitor.hpp"
+
+
+/*********************
+ *
+ * Defining EscapeVisitor methods
+ *
+ ***********************/
+
+EscapeVisitor::EscapeVisitor(TypeTree *t)
+{
+    tt = t;
+    changed = false;
+    final = false;
+    method = NULL;
+    tailCall = false;
+    kept = true;
+    target = NULL;
+    allocations = 0;
+    stackObjects = 0;
+}
+
+void EscapeVisitor::visitProgram(Program *p)
+{
+    // Every method and constructor starts out keeping nothing
+    for (NodeList<Class *>::const_iterator it = p->classes->begin(); it != p->classes->end(); ++it)
+    {
+        string cls = (*it)->clssig->id;
+        captures[cls] = vector<bool>((*it)->clssig->fargs->size() + 1, false);
+        NodeList<Method *> *meths = (*it)->clsbdy->meths;
+        for (NodeList<Method *>::const_iterator m = meths->begin(); m != meths->end(); ++m)
+        {
+            captures[cls + "." + (*m)->id] = vector<bool>((*m)->fargs->size() + 1, false);
+        }
+    }
+    do
+    {
+        changed = false;
+        visitBodies(p);
+    } while (changed);
+
+    final = true;
+    visitBodies(p);
+}
+
+void EscapeVisitor::visitBodies(Program *p)
+{
+    for (NodeList<Class *>::const_iterator it = p->classes->begin(); it != p->classes->end(); ++it)
+    {
+        string cls = (*it)->clssig->id;
+        visitBody(cls, NULL, (*it)->clssig->fargs, (*it)->clsbdy->stmts);
+        NodeList<Method *> *meths = (*it)->clsbdy->meths;
+        for (NodeList<Method *>::const_iterator m = meths->begin(); m != meths->end(); ++m)
+        {
+            visitBody(cls + "." + (*m)->id, (*m)->id, (*m)->fargs, (*m)->stmts);
+        }
+    }
+    visitBody("", NULL, NULL, p->statements);
+}
+
+// Updates the summary 'key' of the body, or marks its sites once final
+void EscapeVisitor::visitBody(const string &key, char *m, NodeList<FormalArg *> *args, NodeList<Statement *> *stmts)
+{
+    method = m;
+    tailCall = false;
+    escaped.clear();
+    candidates.clear();
+    for (NodeList<Statement *>::const_iterator it = stmts->begin(); it != stmts->end(); ++it)
+    {
+        (*it)->accept(this);
+    }
+
+    if (final)
+    {
+        for (list<pair<ConstructorRExpr *, char *> >::const_iterator it = candidates.begin(); it != candidates.end(); ++it)
+        {
+            if (!tailCall && (it->second == NULL || escaped.count(it->second) == 0))
+            {
+                it->first->onStack = true;
+                stackObjects++;
+            }
+        }
+        return;
+    }
+    if (args == NULL)
+        return;
+    vector<bool> summary(1, escaped.count(NAME_THIS) > 0);
+    for (NodeList<FormalArg *>::const_iterator it = args->begin(); it != args->end(); ++it)
+    {
+        summary.push_back(escaped.count((*it)->id) > 0);
+    }
+    if (summary != captures[key])
+    {
+        captures[key] = summary;
+        changed = true;
+    }
+}
+
+// Visits 'r', whose value may be kept if 'keeps'
+void EscapeVisitor::use(RExpr *r, bool keeps)
+{
+    bool outer = kept;
+    kept = keeps;
+    r->accept(this);
+    kept = outer;
+}
+
+// 'recv.m(args)': what it may keep depends on the implementations it reaches
+void EscapeVisitor::call(RExpr *recv, char *m, vector<RExpr *> &args)
+{
+    vector<bool> *summary = NULL;
+    TypeNode *tn = tt->findType(recv->resolvedType);
+    TypeNode *impl = tn == NULL ? NULL : implementation(tn, m);
+    if (impl != NULL)
+    {
+        auto known = captures.find(string(impl->name) + "." + m);
+        if (known != captures.end())
+            summary = &known->second;
+    }
+    use(recv, summary == NULL || (*summary)[0]);
+    for (size_t i = 0; i < args.size(); i++)
+    {
+        use(args[i], summary == NULL || (*summary)[i + 1]);
+    }
+}
+
+// TypeNode::implementation, once for each class and method
+TypeNode *EscapeVisitor::implementation(TypeNode *tn, char *m)
+{
+    string key = string(tn->name) + "." + m;
+    auto known = implementations.find(key);
+    if (known != implementations.end())
+        return known->second;
+    TypeNode *impl = tn->implementation(m);
+    implementations.insert({key, impl});
+    return impl;
+}
+
+void EscapeVisitor::visitAssignmentStatement(AssignmentStatement *a)
+{
+    ObjectFieldLExpr *field = dynamic_cast<ObjectFieldLExpr*>(a->lexpr);
+    if (field != NULL)
+    {
+        use(field->rexpr, false);
+        use(a->rexpr, true);
+        return;
+    }
+    // A new object may live in the variable it is assigned to
+    if (dynamic_cast<ConstructorRExpr*>(a->rexpr) != NULL)
+    {
+        target = dynamic_cast<IdentNode*>(a->lexpr);
+        use(a->rexpr, false);
+    }
+    else
+        use(a->rexpr, true);
+}
+
+void EscapeVisitor::visitReturnStatement(ReturnStatement *r)
+{
+    DotRExpr *d = dynamic_cast<DotRExpr*>(r->rexpr);
+    if (d != NULL && method != NULL && d->id == method)
+        tailCall = true;
+    use(r->rexpr, true);
+}
+
+void EscapeVisitor::visitRExprStatement(RExprStatement *r)
+{
+    use(r->rexpr, false);
+}
+
+void EscapeVisitor::visitDotRExpr(DotRExpr *d)
+{
+    vector<RExpr *> args(d->args->begin(), d->args->end());
+    call(d->rexpr, d->id, args);
+}
+
+void EscapeVisitor::visitConstructorRExpr(ConstructorRExpr *c)
+{
+    IdentNode *var = target;
+    target = NULL;
+    auto known = captures.find(c->id);
+    int i = 1;
+    for (NodeList<RExpr *>::const_iterator it = c->args->begin(); it != c->args->end(); ++it, ++i)
+    {
+        use(*it, known == captures.end() || known->second[i]);
+    }
+    if (!final || known == captures.end())
+        return;
+    allocations++;
+    if (kept || known->second[0])
+        return;
+    // The slot would be cleared under the object being passed
+    for (NodeList<RExpr *>::const_iterator it = c->args->begin(); it != c->args->end(); ++it)
+    {
+        RExprToLExpr *rl = dynamic_cast<RExprToLExpr*>(*it);
+        IdentNode *arg = rl == NULL ? NULL : dynamic_cast<IdentNode*>(rl->lexpr);
+        if (arg != NULL && var != NULL && arg->id == var->id)
+            return;
+    }
+    candidates.push_back({c, var == NULL ? NULL : var->id});
+}
+
+void EscapeVisitor::visitNotNode(NotNode *n)
+{
+    use(n->value, true);
+}
+
+void EscapeVisitor::visitBinaryOperatorNode(BinaryOperatorNode *b)
+{
+    if (b->operation >= 9) // and, or
+    {
+        use(b->left, true);
+        use(b->right, true);
+        return;
+    }
+    vector<RExpr *> args(1, b->right);
+    call(b->left, operatorMethod(b->operation), args);
+}
+
+void EscapeVisitor::visitIdentNode(IdentNode *i)
+{
+    if (kept)
+        escaped.insert(i->id);
+}
+
+// Reading a field does not keep the object
+void EscapeVisitor::visitObjectFieldLExpr(ObjectFieldLExpr *o)
+{
+    use(o->rexpr, false);
+}
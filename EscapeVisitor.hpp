@@ -0,0 +1,90 @@
+/*
+ * The EscapeVisitor runs after constant folding, before code generation.
+ * It finds the objects that never outlive the body that creates them, so
+ * the TranslatorVisitor can put them in a C stack slot of that body
+ * instead of allocating them. An object escapes when it may be
+ *   - stored in a field, or returned
+ *   - assigned from one variable to another
+ *   - passed to a method or constructor that may keep it: a call that can
+ *     reach several implementations, a builtin method, or a method whose
+ *     summary says it keeps that argument
+ * Summaries record, for each method and constructor, whether it may keep
+ * 'this' and each of its arguments. They start out keeping nothing and
+ * are recomputed over the whole program until they stop changing, so
+ * recursive methods get one too.
+ *
+ * A construction qualifies when its value is used only where it is not
+ * kept, or is assigned to a variable that never escapes, and its class's
+ * constructor does not keep 'this'. Each site has one slot per call of the
+ * body, which a loop reuses. The variable holding the previous object is
+ * the only reference to it, and it is overwritten by the new one, so sites
+ * passing that variable to their own constructor stay on the heap. So do
+ * the sites of methods with a tail call to themselves, which reuse the C
+ * frame for the next call.
+ * */
+
+#ifndef ESCAPEVISITOR_H
+#define ESCAPEVISITOR_H
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "visitors.hpp"
+#include "TypeTree.hpp"
+
+using std::list;
+using std::pair;
+using std::string;
+using std::unordered_map;
+using std::unordered_set;
+using std::vector;
+
+class EscapeVisitor : public Visitor
+{
+    private:
+        TypeTree *tt;
+
+        // Whether each method ("Class.method") and constructor ("Class")
+        // may keep 'this' (first) and each argument
+        unordered_map<string, vector<bool> > captures;
+        bool changed; // a summary grew during the last round
+        bool final;   // summaries are complete: mark the sites
+        unordered_map<string, TypeNode *> implementations; // by "Class.method"
+
+        // The body being visited
+        char *method;                  // NULL for constructors and main
+        bool tailCall;                 // it returns a call of its own name
+        unordered_set<char *> escaped; // variables whose value may be kept
+        list<pair<ConstructorRExpr *, char *> > candidates; // and the variable they are assigned to
+        bool kept;                     // the value of the expression visited may be kept
+        IdentNode *target;             // the variable the next construction is assigned to
+
+        void visitBodies(Program *);
+        void visitBody(const string &, char *, NodeList<FormalArg *> *, NodeList<Statement *> *);
+        void use(RExpr *, bool);
+        void call(RExpr *, char *, vector<RExpr *> &);
+        TypeNode *implementation(TypeNode *, char *);
+
+    public:
+        int allocations;  // construction sites of program classes
+        int stackObjects; // those found not to escape
+
+        EscapeVisitor(TypeTree *);
+
+        void visitProgram(Program *);
+        void visitAssignmentStatement(AssignmentStatement *);
+        void visitReturnStatement(ReturnStatement *);
+        void visitRExprStatement(RExprStatement *);
+        void visitDotRExpr(DotRExpr *);
+        void visitConstructorRExpr(ConstructorRExpr *);
+        void visitNotNode(NotNode *);
+        void visitBinaryOperatorNode(BinaryOperatorNode *);
+        void visitIdentNode(IdentNode *);
+        void visitObjectFieldLExpr(ObjectFieldLExpr *);
+};
+
+#endif
@@ -23,84 +23,64 @@ VariableSym::VariableSym(char *i, char *t) : id(i), type(t) {}
 
 MethodSym::MethodSym(char *i, list<VariableSym *> *a, char *r) : id(i), args(a), returnType(r) {}
 
+unsigned long SymbolTable::changes = 0;
+
 SymbolTable::SymbolTable(SymbolTable *p) : parent(p) {}
 
 SymbolTable::~SymbolTable()
 {
     if (parent != NULL)
         delete parent;
-    for (unordered_map<string, VariableSym*>::const_iterator key = vMap.begin(); key != vMap.end(); ++key)
+    for (unordered_map<char *, VariableSym*>::const_iterator key = vMap.begin(); key != vMap.end(); ++key)
     {
         delete key->second;        
     }
 
 }
 
-// note: this intersection does not travel all the way up the symboltable (ignores parent)
-SymbolTable *SymbolTable::intersection(list<SymbolTable*> sts, TypeTree *tt)
+void SymbolTable::join(list<SymbolTable*> &sts, TypeTree *tt)
 {
-    SymbolTable *total = new SymbolTable(parent);
-    bool found = true;
-    VariableSym *v;
-    for (unordered_map<string, VariableSym*>::const_iterator key = vMap.begin(); key != vMap.end(); ++key)
+    for (list<SymbolTable*>::const_iterator table = sts.begin(); table != sts.end(); ++table)
     {
-        char *type = key->second->type;
-        for (list<SymbolTable*>::const_iterator it = sts.begin(); it != sts.end(); ++it)
+        for (unordered_map<char *, VariableSym*>::const_iterator key = (*table)->vMap.begin(); key != (*table)->vMap.end(); ++key)
         {
-            v = (*it)->lookupVariableNoParent(strdup(key->first.c_str()));
-            if (v == NULL)
-            {
-                found = false;
-                break;
-            } 
-            else 
+            bool joined = false; // with an earlier table holding it
+            for (list<SymbolTable*>::const_iterator it = sts.begin(); it != table && !joined; ++it)
+                joined = (*it)->lookupVariableNoParent(key->first) != NULL;
+            if (joined)
+                continue;
+            char *type = key->second->type;
+            for (list<SymbolTable*>::const_iterator it = sts.begin(); it != sts.end() && type != NULL; ++it)
             {
-                type = tt->LCA(type, v->type);
-            } 
+                VariableSym *v = (*it)->lookupVariable(key->first);
+                type = v == NULL ? NULL : tt->LCA(type, v->type);
+            }
+            if (type != NULL)
+                setVariable(key->first, type);
         }
-
-        if (found) 
-        {
-            VariableSym *newVar = new VariableSym(strdup(key->first.c_str()),type);
-            total->addVariable(strdup(key->first.c_str()), newVar);
-        }
-        found = true;
     }
-    return total;    
 }
 
-void SymbolTable::merge(SymbolTable *_st)
+void SymbolTable::removeHeldBy(SymbolTable *st)
 {
-    for (unordered_map<string, VariableSym*>::const_iterator key = _st->vMap.begin(); key != _st->vMap.end(); ++key)
+    for (unordered_map<char *, VariableSym*>::iterator it = vMap.begin(); it != vMap.end(); )
     {
-        VariableSym *v = this->lookupVariableNoParent((char*)key->first.c_str());
-        if (v == NULL)
+        if (st->lookupVariableNoParent(it->first) != NULL)
         {
-            VariableSym *newVar = new VariableSym(strdup(key->first.c_str()), key->second->type);
-            this->addVariable(strdup(key->first.c_str()), newVar);
+            delete it->second;
+            it = vMap.erase(it);
+            changes++;
         }
-    }
-}
-
-SymbolTable *SymbolTable::remove(SymbolTable *st1, SymbolTable *st2)
-{
-    SymbolTable *total = new SymbolTable(st1->parent); //using st1 as the base
-    for (unordered_map<string, VariableSym*>::iterator it = st1->vMap.begin(); it != st1->vMap.end(); ++it)
-    {
-        char *q = (char *) it->first.c_str();
-        VariableSym *v = st2->lookupVariableNoParent(q);
-        if (v == NULL)
+        else
         {
-            total->addVariable(strdup(it->first.c_str()), it->second);
+            ++it;
         }
     }
-    return total;
 }
 
 VariableSym *SymbolTable::lookupVariable(char *name)
 {
-    string key = name;
-    auto search = vMap.find(key);
+    auto search = vMap.find(name);
 
     if (search != vMap.end())
     {
@@ -117,8 +97,7 @@ VariableSym *SymbolTable::lookupVariable(char *name)
 }
 VariableSym *SymbolTable::lookupVariableNoParent(char *name)
 {
-    string key = name;
-    auto search = vMap.find(key);
+    auto search = vMap.find(name);
 
     if (search != vMap.end())
         return search->second;
@@ -128,19 +107,29 @@ VariableSym *SymbolTable::lookupVariableNoParent(char *name)
 
 void SymbolTable::addVariable(char *name, VariableSym *value)
 {
-    string key = name;
-    vMap.insert({key, value});
+    vMap.insert({name, value});
+    changes++;
+}
+
+void SymbolTable::setVariable(char *name, char *type)
+{
+    VariableSym *v = lookupVariableNoParent(name);
+    if (v != NULL)
+        v->type = type;
+    else
+        vMap.insert({name, new VariableSym(name, type)});
+    changes++;
 }
 
 void SymbolTable::removeVariable(VariableSym *vs)
 {
     if (vs != NULL)
     {
-        string key = vs->id;
-        auto search = vMap.find(key);
+        auto search = vMap.find(vs->id);
         if (search != vMap.end())
         {
             vMap.erase(search);    
+            changes++;
         }
     }
 }
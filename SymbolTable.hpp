@@ -2,6 +2,11 @@
  *
  * The SymbolTable is used to keep track of variables during type checking. 
  *
+ * A table only holds the variables of its own scope and looks the others up in
+ * its parents, so opening a scope (for the branch of an if, say) copies
+ * nothing, and every branch shares the table of the scope around it. Joining
+ * the branches writes what they have in common into that table, in place.
+ *
  * */
 
 #ifndef SYMBOLTABLE_H
@@ -27,7 +32,10 @@ class SymbolTable
 {
     public:
         SymbolTable *parent;
-        unordered_map<string, VariableSym *> vMap;
+        unordered_map<char *, VariableSym *> vMap; // by interned name
+
+        // Bumped whenever any table gains or loses a variable
+        static unsigned long changes;
 
         SymbolTable(SymbolTable *p);
        ~SymbolTable();
@@ -35,13 +43,16 @@ class SymbolTable
         VariableSym *lookupVariable(char *name);
         void addVariable(char *name, VariableSym *value);
         void removeVariable(VariableSym *);
+        // Give 'name' the type 'type' in this scope, hiding any variable
+        // of the same name in the parents
+        void setVariable(char *name, char *type);
 
-        // Given a list of SymbolTables, return their intersection
-        SymbolTable *intersection(list<SymbolTable*> sts, TypeTree *tt);
-        // Remove the contents of st2 from st1
-        SymbolTable *remove(SymbolTable *st1, SymbolTable *st2);
-        // Merge the lower-level VariableSym of argument to 'this'
-        void merge(SymbolTable *);
+        // Add the variables some table of 'sts' holds itself and every one
+        // of them can see, in itself or in its parents (this table), as the
+        // LCA of their types
+        void join(list<SymbolTable*> &sts, TypeTree *tt);
+        // Drop the variables that 'st' holds itself
+        void removeHeldBy(SymbolTable *st);
     private:
         VariableSym *lookupVariableNoParent(char *name);
 
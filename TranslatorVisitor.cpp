@@ -6,11 +6,17 @@
  * Separated from visitors.hpp because this is used during code generation, 
  * not type checking. 
  *
+ * Unless 'unbox' is turned off, values whose static type is exactly Int or
+ * Boolean are kept as C ints in locals, arguments and return values, and
+ * arithmetic and comparisons on them become C operators. They are boxed
+ * only when they flow somewhere an object is expected.
+ *
  * */
 
 #include "stdio.h"
 #include "stdlib.h"
 #include "string.h"
+#include "ctype.h"
 
 #include "util.hpp"
 #include "visitors.hpp"
@@ -23,29 +29,132 @@
  *
  * ************/
 
-void printLocalVariables(unordered_map<string, string> typeMap, SymbolTable *st, FILE *f, list<string> *printed = NULL)
+/* Collects the Int and String literals of a program, in the order they appear */
+class LiteralVisitor : public Visitor
+{
+    public:
+        vector<int> ints;
+        vector<char *> strs;
+
+        virtual void visitIntNode(IntNode *i) { ints.push_back(i->value); }
+        virtual void visitStringNode(StringNode *s) { strs.push_back(s->id); }
+};
+
+/* Collects the constructions the EscapeVisitor put on the stack */
+class StackSiteVisitor : public Visitor
+{
+    public:
+        list<ConstructorRExpr *> sites;
+
+        virtual void visitConstructorRExpr(ConstructorRExpr *c)
+        {
+            if (c->onStack)
+                sites.push_back(c);
+            Visitor::visitConstructorRExpr(c);
+        }
+};
+
+/* The C operators used when both sides are unboxed */
+static const char *operatorSymbols[] = {
+    "+", "-", "*", "/", "==", "<=", "<", ">=", ">", "&&", "||"
+};
+
+/* What the class tables in Builtins.c hold for the methods of the
+ * builtin classes that have no subclasses. A method missing here is
+ * still called through the class table */
+static const char *builtinMethods[][3] = {
+    { "Int", "STR", "Int_method_STR" },
+    { "Int", "PRINT", "Int_method_PRINT" },
+    { "Int", "EQUALS", "Int_method_EQUALS" },
+    { "Int", "LESS", "Int_method_LESS" },
+    { "Int", "MORE", "Int_method_MORE" },
+    { "Int", "ATLEAST", "Int_method_ATLEAST" },
+    { "Int", "ATMOST", "Int_method_ATMOST" },
+    { "Int", "PLUS", "Int_method_PLUS" },
+    { "Int", "MINUS", "Int_method_MINUS" },
+    { "Int", "TIMES", "Int_method_TIMES" },
+    { "Int", "DIVIDE", "Int_method_DIVIDE" },
+    { "String", "STR", "String_method_STR" },
+    { "String", "PRINT", "String_method_PRINT" },
+    { "String", "EQUALS", "String_method_EQUALS" },
+    { "String", "PLUS", "String_method_PLUS" },
+    { "String", "ATMOST", "String_method_ATMOST" },
+    { "String", "LESS", "String_method_LESS" },
+    { "String", "ATLEAST", "String_method_ATLEAST" },
+    { "String", "MORE", "String_method_MORE" },
+    { "Boolean", "STR", "Boolean_method_STR" },
+    { "Boolean", "PRINT", "Boolean_method_PRINT" },
+    { "Boolean", "EQUALS", "Obj_method_EQUALS" },
+    { "Nothing", "STR", "Nothing_method_STR" },
+    { "Nothing", "PRINT", "Nothing_method_PRINT" },
+    { "Nothing", "EQUALS", "Obj_method_EQUALS" },
+};
+
+static bool isBuiltin(char *type)
+{
+    return type == NAME_OBJ || type == NAME_INT || type == NAME_STRING
+        || type == NAME_BOOLEAN || type == NAME_NOTHING;
+}
+
+/* Measures the expression returned by a method: its size in nodes, and
+ * whether it calls a method of the program, which keeps it from being
+ * inlined. Operators on builtin types count as nodes, not calls */
+class InlineSizeVisitor : public Visitor
+{
+    public:
+        int size = 0;
+        bool calls = false;
+
+        virtual void visitDotRExpr(DotRExpr *) { calls = true; }
+        virtual void visitConstructorRExpr(ConstructorRExpr *) { calls = true; }
+        virtual void visitEmptyRExpr(EmptyRExpr *) { size++; }
+        virtual void visitIntNode(IntNode *) { size++; }
+        virtual void visitStringNode(StringNode *) { size++; }
+        virtual void visitRExprToLExpr(RExprToLExpr *rl) { size++; Visitor::visitRExprToLExpr(rl); }
+        virtual void visitNotNode(NotNode *n) { size++; Visitor::visitNotNode(n); }
+        virtual void visitBinaryOperatorNode(BinaryOperatorNode *b)
+        {
+            size++;
+            if (!isBuiltin(b->left->resolvedType))
+                calls = true;
+            Visitor::visitBinaryOperatorNode(b);
+        }
+};
+
+/* The bytes a string literal stands for, without its quotes */
+static string unescape(const char *lit)
 {
-    bool unique = true;
-    for (unordered_map<string, VariableSym*>::iterator it = st->vMap.begin(); it != st->vMap.end(); ++it) 
+    string text;
+    for (const char *c = lit + 1; *c != '\0' && c[1] != '\0'; c++)
     {
-        auto q = typeMap.find((*it).second->type);
-        if (q != typeMap.end())
+        if (*c != '\\')
         {
-            if (printed != NULL) //check if local variable is already printed
-            {
-                for (list<string>::iterator iter = printed->begin(); iter != printed->end(); iter++)
-                {
-                    if (strcmp(iter->c_str(), (*it).first.c_str()) == 0)
-                        unique = false;
-                }
-            }
-            if (unique)
-            {
-                fprintf(f, "%s %s;\n", q->second.c_str(), (*it).first.c_str());
-            }
+            text += *c;
+            continue;
+        }
+        switch (*++c)
+        {
+            case '0': text += '\0'; break;
+            case 'b': text += '\b'; break;
+            case 't': text += '\t'; break;
+            case 'n': text += '\n'; break;
+            case 'r': text += '\r'; break;
+            case 'f': text += '\f'; break;
+            default:  text += *c;    break;
         }
-        unique = true;
     }
+    return text;
+}
+
+/* str_hash in Builtins.c, for the literals */
+static unsigned int strHash(const string &text)
+{
+    unsigned int h = 2166136261u;
+    for (string::const_iterator c = text.begin(); c != text.end(); ++c)
+    {
+        h = (h ^ (unsigned char) *c) * 16777619u;
+    }
+    return h == 0 ? 1 : h;
 }
 
 
@@ -74,6 +183,12 @@ TranslatorVisitor::TranslatorVisitor(char *fn, TypeTree *_tt, SymbolTable *_st)
 
     tt = _tt;
     st = _st;
+    frames = 0;
+    returnType = NULL;
+    nativeReturn = false;
+    method = NULL;
+    temps = 0;
+    elses = 0;
 }
 
 TranslatorVisitor::~TranslatorVisitor()
@@ -82,30 +197,50 @@ TranslatorVisitor::~TranslatorVisitor()
 
 void TranslatorVisitor::visitProgram(Program *p)
 {
+    tt->number(); // the hierarchy is complete: class tables carry the numbers
+    tt->flatten(); // and their slots come from the flattened tables
     fprintf(f, "#include \"Builtins.h\"\n");
+    fprintf(f, "#include \"quack_alloc.h\"\n");
+    fprintf(f, "#include <stdbool.h>\n");
     fprintf(f, "#include <stdlib.h>\n\n");
-    for (list<Class *>::const_iterator it = p->classes->begin(); it != p->classes->end(); ++it)
+    printLiterals(p);
+    printDeclarations(p);
+    for (NodeList<Class *>::const_iterator it = p->classes->begin(); it != p->classes->end(); ++it)
     {
         (*it)->accept(this);
     }
     fprintf(f, "int main() {\n");
-    printLocalVariables(typeMap, p->st, f);
-    for (list<Statement *>::const_iterator it = p->statements->begin(); it != p->statements->end(); ++it)
+    list<string> roots;
+    scopes.push_back(unordered_map<string, LocalVar>());
+    printLocalVariables(p->st, &roots);
+    printStackSlots(p->statements);
+    printFrame(&roots, (char*)"__frame");
+    // The builtin class tables take their numbers from the same TypeTree
+    char *builtins[] = { NAME_OBJ, NAME_INT, NAME_STRING, NAME_BOOLEAN, NAME_NOTHING };
+    for (int i = 0; i < (int) (sizeof(builtins) / sizeof(builtins[0])); i++)
     {
-        fprintf(f, "\t");
-        (*it)->accept(this);
-        fprintf(f, ";\n");
+        TypeNode *tn = tt->findType(builtins[i]);
+        fprintf(f, "\tthe_class_%s->type_pre = %d;\n", tn->name, tn->pre);
+        fprintf(f, "\tthe_class_%s->type_last = %d;\n", tn->name, tn->last);
     }
-    fprintf(f, "\n}");
+    for (NodeList<Statement *>::const_iterator it = p->statements->begin(); it != p->statements->end(); ++it)
+    {
+        printStatement(*it);
+    }
+    scopes.pop_back();
+    fprintf(f, "\n}\n");
 }
 
 void TranslatorVisitor::visitClass(Class *c)
 {
     classMethods.clear(); //refresh
-    printed.clear(); //refresh
     c->clssig->accept(this);
+    findInlineBodies(c); // the struct is complete from here on
     c->clsbdy->accept(this);
     fprintf(f, "struct class_%s_struct the_class_%s_struct = {\n", className, className);
+    fprintf(f, "\t.gc_map = %s_gc_map,\n", className);
+    TypeNode *tn = tt->findType(className);
+    fprintf(f, "\t.type_pre = %d,\n\t.type_last = %d,\n", tn->pre, tn->last);
     fprintf(f, "\t.constructor = new_%s,\n", className);
     for (unordered_map<string, string>::const_iterator it = classMethods.begin(); it != classMethods.end(); ++it)
     {
@@ -123,33 +258,38 @@ void TranslatorVisitor::visitClassSignature(ClassSignature *cs)
 {
     className = cs->id;
     TypeNode *tn = tt->findType(cs->id);
-    fprintf(f, "struct class_%s_struct;\n", cs->id);
-    fprintf(f, "typedef struct class_%s_struct* class_%s;\n", cs->id, cs->id);
-    fprintf(f, "typedef struct obj_%s_struct {\n", cs->id);
+    fprintf(f, "struct obj_%s_struct {\n", cs->id);
     fprintf(f, "\tclass_%s clazz;\n", cs->id);
 
-    for (list<VariableNode*>::const_iterator it = tn->instanceVars.begin(); it != tn->instanceVars.end(); ++it)
+    for (vector<VariableNode*>::const_iterator it = tn->fieldTable.begin(); it != tn->fieldTable.end(); ++it)
     {
         string str = (*it)->type;
         auto v = typeMap.find(str);
         fprintf(f, "\t%s %s;\n", v->second.c_str(), (*it)->name);
     }
 
-    fprintf(f, "\n} * obj_%s;\n", cs->id);
+    fprintf(f, "\n};\n");
+    structs.insert(cs->id);
 
-    char c[256];
-    sprintf(c, "obj_%s", cs->id);
-    typeMap.insert({cs->id, c}); 
+    // Pointer map for quack_gc: every instance variable is an object
+    fprintf(f, "static const size_t %s_gc_map[] = {\n", cs->id);
+    for (vector<VariableNode*>::const_iterator it = tn->fieldTable.begin(); it != tn->fieldTable.end(); ++it)
+    {
+        fprintf(f, "\toffsetof(struct obj_%s_struct, %s),\n", cs->id, (*it)->name);
+    }
+    fprintf(f, "\t0\n};\n");
 
     fprintf(f, "struct class_%s_struct the_class_%s_struct;\n", cs->id, cs->id);
     fprintf(f, "extern class_%s the_class_%s;\n", cs->id, cs->id);
 
     fprintf(f, "struct class_%s_struct {\n", cs->id);
+    fprintf(f, "\tconst size_t *gc_map;\n");
+    fprintf(f, "\tint type_pre, type_last;\n");
     fprintf(f, "\tobj_%s (*constructor) (", cs->id); 
     int i = 0; //need to print out constructor args 
-    for (list<FormalArg *>::const_iterator it = cs->fargs->begin(); it != cs->fargs->end(); ++it)
+    for (NodeList<FormalArg *>::const_iterator it = cs->fargs->begin(); it != cs->fargs->end(); ++it)
     {
-        (*it)->accept(this);
+        fprintf(f, "%s", cType((*it)->type, isNativeType((*it)->type)));
         if (i+1 < cs->fargs->size())
         {
             fprintf(f, ", ");
@@ -163,79 +303,80 @@ void TranslatorVisitor::visitClassSignature(ClassSignature *cs)
     getMethodNames(tn); //set the instance variable 'methodNames'
     fprintf(f, "\n};\n\n");
     
-    fprintf(f, "obj_%s new_%s(", cs->id, cs->id);
-    i = 0; 
-    for (list<FormalArg *>::const_iterator it = cs->fargs->begin(); it != cs->fargs->end(); ++it)
+    // Constructors are always called directly, so their arguments
+    // can be unboxed whenever their type allows
+    scopes.push_back(unordered_map<string, LocalVar>());
+    for (NodeList<FormalArg *>::const_iterator it = cs->fargs->begin(); it != cs->fargs->end(); ++it)
     {
-        (*it)->accept(this);
-        printed.push_back((*it)->id);
-        if (i+1 < cs->fargs->size())
-        {
-            fprintf(f, ", ");
-            i++;
-        }
+        declare((*it)->id, (*it)->type, isNativeType((*it)->type));
     }
-    fprintf(f, ") {\n");
+    printConstructorHead(cs, true);
+    fprintf(f, " {\n");
 }
 
+// One slot per entry of the method table: the parent's slots come
+// first, so the class struct starts like its parent's
 void TranslatorVisitor::printMethodSignatures(TypeNode *tn)
 {
-    list<char*> displayed;
-    while (tn != NULL)
+    for (vector<MethodSlot>::const_iterator it = tn->methodTable.begin(); it != tn->methodTable.end(); ++it)
     {
-        for (list<MethodNode*>::const_iterator it = tn->methods.begin(); it != tn->methods.end(); ++it)
+        MethodNode *m = it->method;
+        vector<bool> natives = methodNatives(it->owner, m->id);
+        auto methName = typeMap.find(it->owner->name);
+        fprintf(f, "\t%s (*%s) (%s", cType(m->returnType, natives[0]), m->id, methName->second.c_str());
+        int i = 1;
+        for (list<char*>::const_iterator a = m->argsType.begin(); a != m->argsType.end(); ++a, ++i)
         {
-            MethodNode *m = (*it);
-            if (withinList(&displayed, m->id)) // we've already printed it
-            {
-                continue;
-            }
-            displayed.push_back(m->id);
-            auto ret = typeMap.find(m->returnType);
-            auto methName = typeMap.find(tn->name);
-            fprintf(f, "\t%s (*%s) (%s", ret->second.c_str(), m->id, methName->second.c_str());
-            for (list<char*>::const_iterator it = m->argsType.begin(); it != m->argsType.end(); ++it)
-            {
-                auto arg = typeMap.find((*it));
-                fprintf(f, ", %s", arg->second.c_str());
-            }
-            fprintf(f, ");\n");
+            fprintf(f, ", %s", cType((*a), natives[i]));
         }
-        tn = tn->parent;
+        fprintf(f, ");\n");
     }
 }
  
 //Sets the 'classMethods' instance variable with the appropriate values
 void TranslatorVisitor::getMethodNames(TypeNode *tn)
 {
-    while (tn != NULL)
+    for (vector<MethodSlot>::const_iterator it = tn->methodTable.begin(); it != tn->methodTable.end(); ++it)
     {
-        for (list<MethodNode*>::const_iterator it = tn->methods.begin(); it != tn->methods.end(); ++it)
-        {
-            MethodNode *m = (*it);
-            string key = m->id;
-            char v[256];
-            sprintf(v, "%s_method_%s", tn->name, m->id);
-            string value = v;
-            classMethods.insert({key, value});
-        }
-        tn = tn->parent;
+        string key = it->method->id;
+        char v[256];
+        sprintf(v, "%s_method_%s", it->owner->name, it->method->id);
+        string value = v;
+        classMethods.insert({key, value});
     }
 }
 
 void TranslatorVisitor::visitClassBody(ClassBody *cb)
 {
-    printLocalVariables(typeMap, cb->st, f, &printed);
-    fprintf(f, "\tobj_%s this = malloc(sizeof(struct obj_%s_struct));\n", className, className);
+    list<string> roots; // constructor arguments
+    for (unordered_map<string, LocalVar>::const_iterator it = scopes.back().begin(); it != scopes.back().end(); ++it)
+    {
+        if (!it->second.native)
+            roots.push_back(it->first);
+    }
+    printLocalVariables(cb->st, &roots);
+    printStackSlots(cb->stmts);
+    declare((char*)"this", className, false);
+    roots.push_back("this");
+    printFrame(&roots, (char*)"__frame");
     fprintf(f, "\tthis->clazz = the_class_%s;\n", className);
-    for (list<Statement *>::const_iterator it = cb->stmts->begin(); it != cb->stmts->end(); ++it)
+    for (NodeList<Statement *>::const_iterator it = cb->stmts->begin(); it != cb->stmts->end(); ++it)
     {
-        fprintf(f, "\t");
-        (*it)->accept(this);
-        fprintf(f, "\n");
+        printStatement(*it);
     }
-    fprintf(f, "\treturn this;\n}\n"); 
-    for (list<Method *>::const_iterator it = cb->meths->begin(); it != cb->meths->end(); ++it)
+    fprintf(f, "\treturn quack_return(&__frame, this);\n}\n"); 
+    scopes.pop_back();
+
+    // 'new_<Class>' initializes a block of the heap, zeroed by quack_alloc
+    ClassSignature *cs = signatures.find(className)->second;
+    printConstructorHead(cs, false);
+    fprintf(f, " {\n\treturn init_%s(quack_alloc(sizeof(struct obj_%s_struct))", className, className);
+    for (NodeList<FormalArg *>::const_iterator it = cs->fargs->begin(); it != cs->fargs->end(); ++it)
+    {
+        fprintf(f, ", %s", (*it)->id);
+    }
+    fprintf(f, ");\n}\n");
+    for (NodeList<Method *>::const_iterator it = cb->meths->begin(); it != cb->meths->end(); ++it)
     {
         (*it)->accept(this);
     }
@@ -249,260 +390,278 @@ void TranslatorVisitor::visitFormalArg(FormalArg *fa)
 
 void TranslatorVisitor::visitMethod(Method *m)
 {
-    inMethod = true;
-    methodPrinted.clear();
-    m->ident->accept(this); // print return type first
-    auto q = typeMap.find(className);
-    fprintf(f, " %s_method_%s(%s this", className, m->id, q->second.c_str());
+    TypeNode *tn = tt->findType(className);
+    vector<bool> natives = methodNatives(tn, m->id);
+    returnType = tn->getMethod(m->id)->returnType;
+    nativeReturn = natives[0];
+    method = m;
 
-    for (list<FormalArg *>::const_iterator it = m->fargs->begin(); it != m->fargs->end(); ++it)
+    scopes.push_back(unordered_map<string, LocalVar>());
+    methodScope = scopes.size() - 1;
+    declare((char*)"this", className, false);
+    list<string> roots; // 'this' and the arguments
+    roots.push_back("this");
+
+    int i = 1;
+    for (NodeList<FormalArg *>::const_iterator it = m->fargs->begin(); it != m->fargs->end(); ++it, ++i)
     {
-        fprintf(f, ", ");
-        (*it)->accept(this);
-        methodPrinted.push_back((*it)->id);
+        declare((*it)->id, (*it)->type, natives[i]);
+        if (!natives[i])
+            roots.push_back((*it)->id);
     }
-    fprintf(f, ") {\n");
-    printLocalVariables(typeMap, m->st, f, &methodPrinted);
-    for (list<Statement *>::const_iterator it = m->stmts->begin(); it != m->stmts->end(); ++it)
+    printMethodHead(tn, m);
+    fprintf(f, " {\n");
+    printLocalVariables(m->st, &roots);
+    printStackSlots(m->stmts);
+    printFrame(&roots, (char*)"__frame");
+    if (hasSelfTailCall(m->stmts))
+        fprintf(f, "__start: ;\n");
+    for (NodeList<Statement *>::const_iterator it = m->stmts->begin(); it != m->stmts->end(); ++it)
     {
-        fprintf(f, "\t");
-        (*it)->accept(this);
-        fprintf(f, ";\n");
+        printStatement(*it);
     }
     FalseIdentOption *fi = dynamic_cast<FalseIdentOption*>(m->ident);
     if (fi != NULL)
     {
-        fprintf(f, "\t return nothing;");
+        fprintf(f, "\treturn quack_return(&__frame, nothing);\n");
     }
-    fprintf(f, "\n}\n");
-    inMethod = false;
+    fprintf(f, "}\n");
+    scopes.pop_back();
+    nativeReturn = false;
+    method = NULL;
 }
 
-void TranslatorVisitor::visitTrueIdentOption(TrueIdentOption *t)
+void TranslatorVisitor::visitAssignmentStatement(AssignmentStatement *a)
 {
-    if (inMethod)
+    string target, value;
+    IdentNode *id = dynamic_cast<IdentNode*>(a->lexpr);
+    if (id != NULL)
+    {
+        LocalVar *v = lookup(id->id);
+        target = id->id;
+        value = valueAs(a->rexpr, v == NULL ? NULL : v->type, v != NULL && v->native);
+    }
+    else
     {
-        auto q = typeMap.find(t->id);
-        fprintf(f, "%s", q->second.c_str());
+        ObjectFieldLExpr *o = (ObjectFieldLExpr *) a->lexpr;
+        TypeNode *tn = tt->findType(o->rexpr->resolvedType);
+        a->lexpr->accept(this); // the object whose field is set comes first
+        target = result;
+        value = valueAs(a->rexpr, tn->fieldTable[tn->fieldSlots[o->id]]->type, false);
     }
+    printPrelude();
+    fprintf(f, "%s = %s;", target.c_str(), value.c_str());
 }
 
-void TranslatorVisitor::visitFalseIdentOption(FalseIdentOption *t)
+void TranslatorVisitor::visitReturnStatement(ReturnStatement *r)
 {
-    if (inMethod)
+    if (isSelfCall(r->rexpr))
     {
-        fprintf(f, "obj_Nothing");
+        printTailCall((DotRExpr *) r->rexpr);
+        return;
     }
+    string value = valueOf(r->rexpr, nativeReturn);
+    printPrelude();
+    if (nativeReturn)
+        fprintf(f, "return quack_return_value(&__frame, %s);", value.c_str());
+    else
+        fprintf(f, "return quack_return(&__frame, %s);", value.c_str());
 }
 
-void TranslatorVisitor::visitAssignmentStatement(AssignmentStatement *a)
+void TranslatorVisitor::visitRExprStatement(RExprStatement *r)
 {
-    a->lexpr->accept(this);
-    fprintf(f, " = ");
-    a->rexpr->accept(this);
-    fprintf(f, ";");
+    string value;
+    DotRExpr *d = dynamic_cast<DotRExpr*>(r->rexpr);
+    if (d != NULL) // the result is not needed
+        value = callOf(d->rexpr, d->id, d->args);
+    else
+        value = valueOf(r->rexpr, isNative(r->rexpr));
+    printPrelude();
+    fprintf(f, "%s;", value.c_str());
 }
 
-void TranslatorVisitor::visitReturnStatement(ReturnStatement *r)
+void TranslatorVisitor::visitIfBlock(IfBlock *i)
 {
-    fprintf(f, "return ");
-    r->rexpr->accept(this);
-    fprintf(f, ";");
+    int outer = elses;
+    elses = 0;
+    i->_if->accept(this);
+    for (NodeList<ElifClause *>::const_iterator it = i->_elifs->begin(); it != i->_elifs->end(); ++it)
+    {
+        (*it)->accept(this);
+    }
+    i->_else->accept(this);
+    for (; elses > 0; elses--) // close the else blocks opened by elifs
+    {
+        fprintf(f, "}\n");
+    }
+    elses = outer;
 }
 
 void TranslatorVisitor::visitIfClause(IfClause *i)
 {
-    fprintf(f, "if ((");
-    i->rexpr->accept(this);
-    fprintf(f, ")->value) {\n"); // may need to remove
-    printLocalVariables(typeMap, i->st, f, &methodPrinted);
-    for (list<Statement *>::const_iterator it = i->stmts->begin(); it != i->stmts->end(); ++it)
-    {
-        fprintf(f, "\t");
-        (*it)->accept(this);
-        fprintf(f, ";\n");
-    }
+    string cond = conditionOf(i->rexpr);
+    printPrelude();
+    fprintf(f, "if (%s) {\n", cond.c_str());
+    printBlock(i->st, i->stmts);
     fprintf(f, "\n}\n");
 }
 
 void TranslatorVisitor::visitElifClause(ElifClause *e)
 {
-    fprintf(f, "else if (");
-    e->rexpr->accept(this);
-    fprintf(f, ") {\n");
-    printLocalVariables(typeMap, e->st, f, &methodPrinted);
-    for (list<Statement *>::const_iterator it = e->stmts->begin(); it != e->stmts->end(); ++it)
+    string cond = conditionOf(e->rexpr);
+    if (prelude.size() > 0)
     {
-        fprintf(f, "\t");
-        (*it)->accept(this);
-        fprintf(f, ";\n");
+        // The condition's temporaries may only be computed once the
+        // conditions before it failed
+        fprintf(f, "else {\n\t");
+        printPrelude();
+        fprintf(f, "if (%s) {\n", cond.c_str());
+        elses++;
+    }
+    else
+    {
+        fprintf(f, "else if (%s) {\n", cond.c_str());
     }
+    printBlock(e->st, e->stmts);
     fprintf(f, "\n}\n");
 }
 
 void TranslatorVisitor::visitTrueElseOption(TrueElseOption *e)
 {
     fprintf(f, "else {\n");
-    printLocalVariables(typeMap, e->st, f, &methodPrinted);
-    for (list<Statement *>::const_iterator it = e->stmts->begin(); it != e->stmts->end(); ++it)
-    {
-        fprintf(f, "\t");
-        (*it)->accept(this);
-        fprintf(f, ";\n");
-    }
+    printBlock(e->st, e->stmts);
     fprintf(f, "\n}\n");
 }
 
 void TranslatorVisitor::visitWhileStatement(WhileStatement *w)
 {
-    fprintf(f, "while (");
-    w->rexpr->accept(this);
-    fprintf(f, "->value) {\n"); //since rexpr is of type boolean, must access value
-    for (list<Statement *>::const_iterator it = w->stmts->begin(); it != w->stmts->end(); ++it)
+    string cond = conditionOf(w->rexpr);
+    if (prelude.size() > 0)
     {
-        (*it)->accept(this);
+        // The condition needs temporaries: compute them on every iteration
+        fprintf(f, "while (1) {\n\t");
+        printPrelude();
+        fprintf(f, "if (!%s) break;\n", cond.c_str());
+    }
+    else
+    {
+        fprintf(f, "while (%s) {\n", cond.c_str());
+    }
+    fprintf(f, "\tquack_safepoint(&__frame);\n"); // drop the condition's temporaries
+    for (NodeList<Statement *>::const_iterator it = w->stmts->begin(); it != w->stmts->end(); ++it)
+    {
+        printStatement(*it);
     }
     fprintf(f, "\n}\n");
 }
 
 void TranslatorVisitor::visitConstructorRExpr(ConstructorRExpr *c)
 {
-    fprintf(f, "new_%s(", c->id);
-    for (list<RExpr *>::const_iterator it = c->args->begin(); it != c->args->end(); )
+    auto sig = signatures.find(c->id);
+    string args;
+    if (sig != signatures.end()) // builtin constructors take no arguments
     {
-        (*it)->accept(this);
-        if (++it != c->args->end())
+        NodeList<FormalArg *>::const_iterator farg = sig->second->fargs->begin();
+        for (NodeList<RExpr *>::const_iterator it = c->args->begin(); it != c->args->end(); ++farg)
         {
-            fprintf(f, ", ");
+            args += valueAs(*it, (*farg)->type, isNativeType((*farg)->type));
+            if (++it != c->args->end())
+            {
+                args += ", ";
+            }
         }
     }
-    fprintf(f, ")");
+    string call = string("new_") + c->id + "(" + args + ")";
+    auto slot = slots.find(c);
+    if (slot != slots.end())
+    {
+        // Cleared once the arguments are computed, since they may read
+        // the object the slot held the last time round a loop
+        prelude += "memset(&" + slot->second + ", 0, sizeof " + slot->second + ");\n\t";
+        call = string("init_") + c->id + "(&" + slot->second + (args.empty() ? "" : ", " + args) + ")";
+    }
+    result = temp(typeMap.find(c->id)->second.c_str(), call);
+}
+
+void TranslatorVisitor::visitEmptyRExpr(EmptyRExpr *)
+{
+    result = "nothing";
 }
 
 void TranslatorVisitor::visitIntNode(IntNode *i)
 {
-    fprintf(f, "int_literal(%d)", i->value);
+    char value[32];
+    sprintf(value, "(%d)", i->value);
+    if (unbox)
+        result = value;
+    else
+        result = "(&" + intLiterals[i->value] + ")";
 }
 
 void TranslatorVisitor::visitStringNode(StringNode *s)
 {
-    fprintf(f, "str_literal(%s)", s->id);
+    result = "(&" + strLiterals[s->id] + ")";
 }
 
 void TranslatorVisitor::visitNotNode(NotNode *n)
 {
-    fprintf(f, "!(");
-    n->value->accept(this);
-    fprintf(f, ")");
+    result = conditionOf(n);
+    if (!unbox)
+        result = "(" + result + " ? lit_true : lit_false)";
 }
 
 void TranslatorVisitor::visitBinaryOperatorNode(BinaryOperatorNode *b)
 {
-    switch(b->operation) {
-        case 0:
-            b->left->accept(this);
-            fprintf(f, "->clazz->");
-            fprintf(f, "PLUS");
-            break;
-        case 1:
-            b->left->accept(this);
-            fprintf(f, "->clazz->");
-            fprintf(f, "MINUS");
-            break;
-        case 2:
-            b->left->accept(this);
-            fprintf(f, "->clazz->");
-            fprintf(f, "TIMES");
-            break;
-        case 3:
-            b->left->accept(this);
-            fprintf(f, "->clazz->");
-            fprintf(f, "DIVIDE");
-            break;
-        case 4:
-            b->left->accept(this);
-            fprintf(f, "->clazz->");
-            fprintf(f, "EQUALS");
-            break;
-        case 5:
-            b->left->accept(this);
-            fprintf(f, "->clazz->");
-            fprintf(f, "ATMOST");
-            break;
-        case 6:
-            b->left->accept(this);
-            fprintf(f, "->clazz->");
-            fprintf(f, "LESS");
-            break;
-        case 7:
-            b->left->accept(this);
-            fprintf(f, "->clazz->");
-            fprintf(f, "ATLEAST");
-            break;
-        case 8:
-            b->left->accept(this);
-            fprintf(f, "->clazz->");
-            fprintf(f, "MORE");
-            break;
-        case 9:
-            fprintf(f, "((");
-            b->left->accept(this);
-            fprintf(f, "->value) ? (");
-            b->right->accept(this);
-            fprintf(f, ") : lit_false)");
-            return;
-            break;
-        case 10:
-            fprintf(f, "((");
-            b->left->accept(this);
-            fprintf(f, "->value ) ? lit_true : (");
-            b->right->accept(this);
-            fprintf(f, "))");
-            return;
-            break;
-        default:
-            break;
-    }
-    fprintf(f, "(");
-    b->left->accept(this); // Just a way of visiting printing left again
-    fprintf(f, ", ");
-    b->right->accept(this);
-    fprintf(f, ")");
-
-
+    if (b->operation >= 9) // and, or
+    {
+        result = conditionOf(b);
+        if (!nativeOperator(b))
+            result = "(" + result + " ? lit_true : lit_false)";
+        return;
+    }
+    if (nativeOperator(b))
+    {
+        string left = valueOf(b->left, true);
+        string right = valueOf(b->right, true);
+        result = "(" + left + " " + operatorSymbols[b->operation] + " " + right + ")";
+        return;
+    }
+    NodeList<RExpr *> args;
+    args.push_back(b->right);
+    result = temp(resultType(b), callOf(b->left, operatorMethod(b->operation), &args));
 }
 
 void TranslatorVisitor::visitIdentNode(IdentNode *i)
 {
     string str = i->id;
+    auto renamed = renames.find(str);
+    if (renamed != renames.end())
+    {
+        result = renamed->second;
+        return;
+    }
     auto q = keywords.find(str);
     if (q != keywords.end())
     {
-        fprintf(f, "%s", q->second.c_str());
+        if (unbox)
+            result = i->id == NAME_TRUE ? "1" : "0";
+        else
+            result = q->second;
     } 
     else
     {
-        fprintf(f, "%s", i->id);
+        result = i->id;
     }
 }
 
 void TranslatorVisitor::visitObjectFieldLExpr(ObjectFieldLExpr *o)
 {
-    o->rexpr->accept(this);
-    fprintf(f, "->%s", o->id); 
+    result = valueOf(o->rexpr, false) + "->" + o->id;
 }
 
 void TranslatorVisitor::visitDotRExpr(DotRExpr *d) 
 {
-    d->rexpr->accept(this);
-    fprintf(f, "->clazz->%s(", d->id);
-    d->rexpr->accept(this); // Just a way to print out first argument of methods
-    for (list<RExpr *>::const_iterator it = d->args->begin(); it != d->args->end(); ++it)
-    {
-        fprintf(f, ", ");
-        (*it)->accept(this);
-    }
-    fprintf(f, ")");
+    result = temp(resultType(d), callOf(d->rexpr, d->id, d->args));
 }    
 
 
@@ -541,34 +700,78 @@ ObjectFieldLExpr *TranslatorVisitor::isOFL(RExpr *r)
     return NULL;
 }
 
-char *TranslatorVisitor::getType(RExpr *r)
+// Print every distinct literal of the program as a static object, so 
+// evaluating a literal costs nothing at run time
+void TranslatorVisitor::printLiterals(Program *p)
 {
-    char *type;
-    type = r->type();
-    if (strcmp(type, (char*)"-") != 0) //type covered because it's a literal or easy to identify
-        return type;
-
-    PlusNode *plus = dynamic_cast<PlusNode*>(r);
-    if (plus != NULL)
+    LiteralVisitor lv;
+    p->accept(&lv);
+    char name[32];
+    for (vector<int>::const_iterator it = lv.ints.begin(); it != lv.ints.end(); ++it)
     {
-        return getType(plus->left);
+        if (intLiterals.find(*it) != intLiterals.end())
+            continue;
+        if (*it < 0) // folding makes negative literals
+            sprintf(name, "lit_int_neg%d", -*it);
+        else
+            sprintf(name, "lit_int_%d", *it);
+        intLiterals.insert({*it, name});
+        fprintf(f, "static struct obj_Int_struct %s = { &the_class_Int_struct, %d };\n", name, *it);
     }
-    MinusNode *minus = dynamic_cast<MinusNode*>(r);
-    if (minus != NULL)
+    for (vector<char *>::const_iterator it = lv.strs.begin(); it != lv.strs.end(); ++it)
     {
-        return getType(minus->left);
+        if (strLiterals.find(*it) != strLiterals.end())
+            continue;
+        sprintf(name, "lit_str_%d", (int) strLiterals.size());
+        strLiterals.insert({*it, name});
+        string text = unescape(*it);
+        fprintf(f, "static struct obj_String_struct %s = { &the_class_String_struct, %d, %uu, %s, NULL, NULL };\n",
+                name, (int) text.size(), strHash(text), *it);
     }
-    TimesNode *times = dynamic_cast<TimesNode*>(r);
-    if (times != NULL)
+    fprintf(f, "\n");
+}
+
+// Push a shadow stack frame named 'name' whose roots are the locals in 'roots'
+void TranslatorVisitor::printFrame(list<string> *roots, char *name)
+{
+    fprintf(f, "\tvoid *%s_roots[] = { ", name);
+    for (list<string>::const_iterator it = roots->begin(); it != roots->end(); ++it)
     {
-        return getType(times->left);
+        fprintf(f, "&%s, ", it->c_str());
     }
-    DivideNode *divide = dynamic_cast<DivideNode*>(r);
-    if (divide != NULL)
+    fprintf(f, "NULL };\n");
+    fprintf(f, "\tstruct quack_frame %s;\n", name);
+    fprintf(f, "\tquack_enter(&%s, %s_roots, %d);\n", name, name, (int) roots->size());
+}
+
+// Print a statement, then let go of the temporaries it made. Nothing
+// after a return runs
+void TranslatorVisitor::printStatement(Statement *s)
+{
+    fprintf(f, "\t");
+    s->accept(this);
+    fprintf(f, "\n");
+    if (dynamic_cast<ReturnStatement*>(s) == NULL)
+        fprintf(f, "\tquack_safepoint(&__frame);\n");
+}
+
+// Print the body of an if/elif/else; its own locals get a nested frame
+void TranslatorVisitor::printBlock(SymbolTable *blockSt, NodeList<Statement *> *stmts)
+{
+    list<string> roots;
+    char name[32];
+    scopes.push_back(unordered_map<string, LocalVar>());
+    printLocalVariables(blockSt, &roots);
+    sprintf(name, "__frame%d", ++frames);
+    if (roots.size() > 0)
+        printFrame(&roots, name);
+    for (NodeList<Statement *>::const_iterator it = stmts->begin(); it != stmts->end(); ++it)
     {
-        return getType(divide->left);
+        printStatement(*it);
     }
-    return strdup((char*)"-");
+    if (roots.size() > 0)
+        fprintf(f, "\tquack_leave(&%s);\n", name);
+    scopes.pop_back();
 }
 
 void TranslatorVisitor::printRExpr(RExpr *r)
@@ -579,3 +782,637 @@ void TranslatorVisitor::printRExpr(RExpr *r)
         fprintf(f, "%s", ident->id);
     }
 }
+
+// Declare the variables of 'vars', which type resolution left holding
+// only those not already visible. Locals start out NULL so the collector
+// never sees garbage; the boxed ones go in 'roots'
+void TranslatorVisitor::printLocalVariables(SymbolTable *vars, list<string> *roots)
+{
+    for (unordered_map<char *, VariableSym*>::iterator it = vars->vMap.begin(); it != vars->vMap.end(); ++it)
+    {
+        char *name = (*it).first;
+        char *type = (*it).second->type;
+        bool native = isNativeType(type);
+        if (native)
+        {
+            fprintf(f, "%s %s = 0;\n", cType(type, true), name);
+        }
+        else
+        {
+            fprintf(f, "%s %s = NULL;\n", cType(type, false), name);
+            roots->push_back(name);
+        }
+        declare(name, type, native);
+    }
+}
+
+void TranslatorVisitor::declare(char *name, char *type, bool native)
+{
+    LocalVar v;
+    v.type = type;
+    v.native = native;
+    scopes.back()[name] = v;
+}
+
+LocalVar *TranslatorVisitor::lookup(char *name)
+{
+    for (vector<unordered_map<string, LocalVar> >::reverse_iterator it = scopes.rbegin(); it != scopes.rend(); ++it)
+    {
+        auto v = it->find(name);
+        if (v != it->end())
+            return &v->second;
+    }
+    return NULL;
+}
+
+// Is every object of 'type' an Int or a Boolean, whose value is all
+// there is to it? Not if a program subclasses them
+bool TranslatorVisitor::isValueType(char *type)
+{
+    if (type != NAME_INT && type != NAME_BOOLEAN)
+        return false;
+    TypeNode *tn = tt->findType(type);
+    return tn != NULL && tn->children.empty();
+}
+
+// Values of type Int and Boolean are unboxed, unless a program
+// subclasses them
+bool TranslatorVisitor::isNativeType(char *type)
+{
+    return unbox && isValueType(type);
+}
+
+// Is 'r' printed as a C value rather than an object?
+bool TranslatorVisitor::isNative(RExpr *r)
+{
+    if (!unbox)
+        return false;
+    if (dynamic_cast<IntNode*>(r) != NULL || dynamic_cast<NotNode*>(r) != NULL)
+        return true;
+    IdentNode *ident = isIdent(r);
+    if (ident != NULL)
+    {
+        if (keywords.find(ident->id) != keywords.end())
+            return true;
+        LocalVar *v = lookup(ident->id);
+        return v != NULL && v->native;
+    }
+    DotRExpr *dot = dynamic_cast<DotRExpr*>(r);
+    if (dot != NULL)
+    {
+        TypeNode *tn = tt->findType(dot->rexpr->resolvedType);
+        return tn != NULL && methodNatives(tn, dot->id)[0];
+    }
+    BinaryOperatorNode *b = dynamic_cast<BinaryOperatorNode*>(r);
+    if (b != NULL)
+    {
+        if (nativeOperator(b))
+            return true;
+        if (b->operation >= 9)
+            return false;
+        TypeNode *tn = tt->findType(b->left->resolvedType);
+        return tn != NULL && methodNatives(tn, operatorMethod(b->operation))[0];
+    }
+    return false;
+}
+
+// Can 'b' be computed with a C operator?
+bool TranslatorVisitor::nativeOperator(BinaryOperatorNode *b)
+{
+    if (!unbox)
+        return false;
+    char *left = b->left->resolvedType;
+    if (b->operation >= 9) // and, or
+        return isNativeType(NAME_BOOLEAN);
+    if (left == NAME_INT)
+        return isNativeType(left);
+    if (b->operation == 4 && left == NAME_BOOLEAN)
+        return isNativeType(left) && b->right->resolvedType == NAME_BOOLEAN;
+    return false;
+}
+
+// Which of the return value (index 0) and arguments (1..) of method
+// 'name', as seen from 'tn', are unboxed. Every override shares a vtable
+// slot, so a position is unboxed only if the class that introduced the
+// method is ours and all its overrides agree on an unboxed type there
+vector<bool> TranslatorVisitor::methodNatives(TypeNode *tn, char *name)
+{
+    TypeNode *origin = tn->methodOrigin(name);
+    MethodNode *m = tn->getMethod(name);
+    vector<bool> natives(m == NULL ? 1 : m->argsType.size() + 1, false);
+    if (origin == NULL || isBuiltin(origin->name))
+        return natives;
+
+    string key = string(origin->name) + "." + name;
+    auto known = families.find(key);
+    if (known != families.end())
+        return known->second;
+
+    // Gather the types at each position over the family
+    vector<char *> types;
+    list<TypeNode *> work;
+    bool first = true;
+    work.push_back(origin);
+    while (!work.empty())
+    {
+        TypeNode *t = work.front();
+        work.pop_front();
+        for (list<TypeNode *>::const_iterator it = t->children.begin(); it != t->children.end(); ++it)
+            work.push_back(*it);
+        for (list<MethodNode*>::const_iterator it = t->methods.begin(); it != t->methods.end(); ++it)
+        {
+            if ((*it)->id != name)
+                continue;
+            vector<char *> these;
+            these.push_back((*it)->returnType);
+            for (list<char*>::const_iterator a = (*it)->argsType.begin(); a != (*it)->argsType.end(); ++a)
+                these.push_back(*a);
+            if (first)
+                types = these;
+            for (int i = 0; i < (int) types.size() && i < (int) these.size(); i++)
+            {
+                if (types[i] != NULL && types[i] != these[i])
+                    types[i] = NULL;
+            }
+            first = false;
+        }
+    }
+    for (int i = 0; i < (int) natives.size() && i < (int) types.size(); i++)
+    {
+        natives[i] = types[i] != NULL && isNativeType(types[i]);
+    }
+    families.insert({key, natives});
+    return natives;
+}
+
+// The C type of a value of Quack type 'type'
+const char *TranslatorVisitor::cType(char *type, bool native)
+{
+    if (native)
+        return type == NAME_BOOLEAN ? "bool" : "int";
+    return typeMap.find(type)->second.c_str();
+}
+
+// 'r' as a C value if 'native', as an object otherwise, boxing or
+// unboxing it on the way. Any temporaries it needs go to 'prelude'
+string TranslatorVisitor::valueOf(RExpr *r, bool native)
+{
+    r->accept(this);
+    string value = result;
+    ObjectFieldLExpr *ofl = isOFL(r);
+    if (ofl != NULL)
+    {
+        // Read the field now: a call later in the expression may change it
+        char *type = r->resolvedType;
+        if (native && isNativeType(type))
+            return temp(cType(type, true), "(" + value + ")->value");
+        value = temp(cType(type, false), value);
+        prelude += "quack_gc_keep(" + value + ");\n\t";
+        if (!native)
+            return value;
+        return "(" + value + ")->value";
+    }
+    if (isNative(r) == native)
+        return value;
+    IntNode *i = dynamic_cast<IntNode*>(r);
+    IdentNode *ident = isIdent(r);
+    if (native && i != NULL)
+    {
+        char literal[32];
+        sprintf(literal, "(%d)", i->value);
+        return literal;
+    }
+    if (native && ident != NULL && keywords.find(ident->id) != keywords.end())
+        return ident->id == NAME_TRUE ? "1" : "0";
+    if (native)
+        return "(" + value + ")->value";
+    if (i != NULL)
+        return "(&" + intLiterals[i->value] + ")";
+    if (ident != NULL && keywords.find(ident->id) != keywords.end())
+        return keywords[ident->id];
+    if (r->resolvedType == NAME_BOOLEAN)
+        return "((" + value + ") ? lit_true : lit_false)";
+    return "int_literal(" + value + ")";
+}
+
+// 'r' where C expects a value of Quack type 'type'. C has no subclasses,
+// so an object of another class, a literal included, is cast to it
+string TranslatorVisitor::valueAs(RExpr *r, char *type, bool native)
+{
+    string value = valueOf(r, native);
+    if (native || type == NULL || type == r->resolvedType)
+        return value;
+    return "(" + string(cType(type, false)) + ") " + value;
+}
+
+/* 'r', a Boolean, as a C truth value, for a condition. and, or, not
+ * and the comparisons of Ints or Booleans become C operators on the
+ * values, so no Boolean object is made or read, boxed or not */
+string TranslatorVisitor::conditionOf(RExpr *r)
+{
+    NotNode *n = dynamic_cast<NotNode*>(r);
+    if (n != NULL)
+        return "(!" + conditionOf(n->value) + ")";
+    BinaryOperatorNode *b = dynamic_cast<BinaryOperatorNode*>(r);
+    if (b != NULL && b->operation >= 9) // the right side is evaluated only if needed
+    {
+        string left = conditionOf(b->left);
+        string saved = prelude;
+        prelude = "";
+        string right = conditionOf(b->right);
+        string rightPrelude = prelude;
+        prelude = saved;
+        if (rightPrelude.size() == 0)
+            return "(" + left + " " + operatorSymbols[b->operation] + " " + right + ")";
+        string cond = temp("bool", b->operation == 9 ? "0" : "1");
+        prelude += string("if (") + (b->operation == 9 ? "" : "!") + left + ") {\n\t";
+        prelude += rightPrelude;
+        prelude += cond + " = " + right + ";\n\t}\n\t";
+        return cond;
+    }
+    if (b != NULL && b->operation >= 4 && isValueType(b->left->resolvedType)
+        && b->left->resolvedType == b->right->resolvedType)
+    {
+        string left = valueOf(b->left, true);
+        string right = valueOf(b->right, true);
+        return "(" + left + " " + operatorSymbols[b->operation] + " " + right + ")";
+    }
+    return valueOf(r, true);
+}
+
+// A call of 'method' on 'recv'. The receiver and then the arguments
+// are evaluated once each, left to right
+string TranslatorVisitor::callOf(RExpr *recv, const char *method, NodeList<RExpr *> *args)
+{
+    TypeNode *tn = tt->findType(recv->resolvedType);
+    vector<bool> natives(args->size() + 1, false);
+    string direct;
+    if (tn != NULL)
+    {
+        natives = methodNatives(tn, (char*)method);
+        direct = directCall(tn, method);
+    }
+    callSites++;
+    string call, self;
+    if (direct == "Int_method_PRINT" && isNative(recv))
+    {
+        // Printing an unboxed Int does not need the box
+        directCalls++;
+        return "int_print(" + valueOf(recv, true) + ")";
+    }
+    if (direct.size() > 0)
+    {
+        // The receiver is passed as the class that implements the method
+        directCalls++;
+        auto body = inlineBodies.find(direct);
+        if (body != inlineBodies.end())
+            return inlinedCall(tn->methodOwner((char*)method), body->second, recv, args, natives);
+        call = direct + "((obj_" + direct.substr(0, direct.find("_method_")) + ") " + valueOf(recv, false);
+    }
+    else
+    {
+        self = atomOf(recv); // used twice: for the method table and as 'this'
+        call = self + "->clazz->" + method + "(" + self;
+    }
+    string rest;
+    int i = 1;
+    list<char *> types;
+    if (tn != NULL)
+        types = tn->getMethod((char*)method)->argsType;
+    list<char *>::const_iterator type = types.begin();
+    for (NodeList<RExpr *>::const_iterator it = args->begin(); it != args->end(); ++it, ++i)
+    {
+        char *expected = type == types.end() ? NULL : *type++;
+        rest += ", " + valueAs(*it, expected, i < (int) natives.size() && natives[i]);
+    }
+    call += rest + ")";
+    if (direct.size() == 0 && tn != NULL)
+        return switchCall(tn, method, self, rest, call);
+    return call;
+}
+
+// Is 'r' a call of the method being printed that can reach no other
+// implementation? Then returning it is a self tail call, unless a block
+// hides an argument behind a local of its own
+bool TranslatorVisitor::isSelfCall(RExpr *r)
+{
+    DotRExpr *d = dynamic_cast<DotRExpr*>(r);
+    if (d == NULL || method == NULL || d->id != method->id)
+        return false;
+    TypeNode *tn = tt->findType(d->rexpr->resolvedType);
+    if (tn == NULL || directCall(tn, d->id) != string(className) + "_method_" + method->id)
+        return false;
+    for (NodeList<FormalArg *>::const_iterator it = method->fargs->begin(); it != method->fargs->end(); ++it)
+    {
+        for (size_t s = methodScope + 1; s < scopes.size(); s++)
+        {
+            if (scopes[s].find((*it)->id) != scopes[s].end())
+                return false;
+        }
+    }
+    return true;
+}
+
+bool TranslatorVisitor::hasSelfTailCall(NodeList<Statement *> *stmts)
+{
+    for (NodeList<Statement *>::const_iterator it = stmts->begin(); it != stmts->end(); ++it)
+    {
+        ReturnStatement *r = dynamic_cast<ReturnStatement*>(*it);
+        WhileStatement *w = dynamic_cast<WhileStatement*>(*it);
+        IfBlock *i = dynamic_cast<IfBlock*>(*it);
+        if (r != NULL && isSelfCall(r->rexpr))
+            return true;
+        if (w != NULL && hasSelfTailCall(w->stmts))
+            return true;
+        if (i == NULL)
+            continue;
+        if (hasSelfTailCall(i->_if->stmts))
+            return true;
+        for (NodeList<ElifClause *>::const_iterator e = i->_elifs->begin(); e != i->_elifs->end(); ++e)
+        {
+            if (hasSelfTailCall((*e)->stmts))
+                return true;
+        }
+        TrueElseOption *tso = dynamic_cast<TrueElseOption*>(i->_else);
+        if (tso != NULL && hasSelfTailCall(tso->stmts))
+            return true;
+    }
+    return false;
+}
+
+// 'return d', a self tail call. The receiver and arguments are computed
+// before any of them is rebound, since they may read the old values
+void TranslatorVisitor::printTailCall(DotRExpr *d)
+{
+    TypeNode *tn = tt->findType(className);
+    vector<bool> natives = methodNatives(tn, method->id);
+    callSites++;
+    directCalls++;
+    tailCalls++;
+    string self = valueOf(d->rexpr, false);
+    vector<string> values;
+    NodeList<FormalArg *>::const_iterator farg = method->fargs->begin();
+    int i = 1;
+    for (NodeList<RExpr *>::const_iterator it = d->args->begin(); it != d->args->end(); ++it, ++farg, ++i)
+    {
+        values.push_back(temp(cType((*farg)->type, natives[i]), valueAs(*it, (*farg)->type, natives[i])));
+    }
+    printPrelude();
+    if (self != "this")
+        fprintf(f, "this = (obj_%s) %s;\n\t", className, self.c_str());
+    farg = method->fargs->begin();
+    for (vector<string>::const_iterator it = values.begin(); it != values.end(); ++it, ++farg)
+    {
+        fprintf(f, "%s = %s;\n\t", (*farg)->id, it->c_str());
+    }
+    fprintf(f, "quack_restart(&__frame);\n\tgoto __start;");
+}
+
+// A dynamic call as a switch on the receiver's class: the overrides of
+// 'method' below 'tn' are tested deepest first, each by its range of
+// class numbers (quack_instance_of), and a match calls that override
+// directly. What 'tn' itself runs is left last, untested. 'call' goes
+// through the class table, and is kept when there are more than
+// 'switchSize' implementations
+string TranslatorVisitor::switchCall(TypeNode *tn, const char *method, string self, string args, string call)
+{
+    if (isBuiltin(tn->name))
+        return call;
+    vector<TypeNode *> overrides; // breadth first, so by depth
+    list<TypeNode *> work(tn->children.begin(), tn->children.end());
+    while (!work.empty())
+    {
+        TypeNode *t = work.front();
+        work.pop_front();
+        if (t->methodOwner((char*)method) == t)
+        {
+            overrides.push_back(t);
+            if ((int) overrides.size() >= switchSize)
+                return call; // megamorphic
+        }
+        work.insert(work.end(), t->children.begin(), t->children.end());
+    }
+    switchedCalls++;
+
+    MethodNode *mn = tn->getMethod((char*)method);
+    const char *type = cType(mn->returnType, methodNatives(tn, (char*)method)[0]);
+    char entry[512];
+    string cases = "(";
+    for (vector<TypeNode *>::const_reverse_iterator it = overrides.rbegin(); it != overrides.rend(); ++it)
+    {
+        sprintf(entry, "quack_instance_of((obj_Obj) %s, (class_Obj) &the_class_%s_struct) ? (%s) %s_method_%s((obj_%s) ",
+                self.c_str(), (*it)->name, type, (*it)->name, method, (*it)->name);
+        cases += entry + self + args + ") : ";
+    }
+    TypeNode *def = tn->methodOwner((char*)method);
+    sprintf(entry, "(%s) %s_method_%s((obj_%s) ", type, def->name, method, def->name);
+    return cases + entry + self + args + "))";
+}
+
+// 'r' as an object held by a plain name, so it can be used twice
+string TranslatorVisitor::atomOf(RExpr *r)
+{
+    string value = valueOf(r, false);
+    for (string::const_iterator c = value.begin(); c != value.end(); ++c)
+    {
+        if (!isalnum(*c) && *c != '_')
+            return temp(cType(r->resolvedType, false), value);
+    }
+    return value;
+}
+
+// Declare a temporary holding 'value', in 'prelude'
+string TranslatorVisitor::temp(const char *type, string value)
+{
+    char name[32];
+    sprintf(name, "__t%d", ++temps);
+    prelude += string(type) + " " + name + " = " + value + ";\n\t";
+    return name;
+}
+
+// Print the temporaries the current statement needs
+void TranslatorVisitor::printPrelude()
+{
+    fprintf(f, "%s", prelude.c_str());
+    prelude = "";
+}
+
+// C type of the value 'r' evaluates to
+const char *TranslatorVisitor::resultType(RExpr *r)
+{
+    return cType(r->resolvedType, isNative(r));
+}
+
+// Declare every class type, constructor and method up front
+void TranslatorVisitor::printDeclarations(Program *p)
+{
+    for (NodeList<Class *>::const_iterator it = p->classes->begin(); it != p->classes->end(); ++it)
+    {
+        char *id = (*it)->clssig->id;
+        signatures.insert({id, (*it)->clssig});
+        fprintf(f, "struct obj_%s_struct;\n", id);
+        fprintf(f, "typedef struct obj_%s_struct* obj_%s;\n", id, id);
+        fprintf(f, "struct class_%s_struct;\n", id);
+        fprintf(f, "typedef struct class_%s_struct* class_%s;\n", id, id);
+        fprintf(f, "extern struct class_%s_struct the_class_%s_struct;\n", id, id);
+        char c[256];
+        sprintf(c, "obj_%s", id);
+        typeMap.insert({id, c});
+    }
+    for (NodeList<Class *>::const_iterator it = p->classes->begin(); it != p->classes->end(); ++it)
+    {
+        TypeNode *tn = tt->findType((*it)->clssig->id);
+        printConstructorHead((*it)->clssig, true);
+        fprintf(f, ";\n");
+        printConstructorHead((*it)->clssig, false);
+        fprintf(f, ";\n");
+        for (NodeList<Method *>::const_iterator m = (*it)->clsbdy->meths->begin(); m != (*it)->clsbdy->meths->end(); ++m)
+        {
+            printMethodHead(tn, *m);
+            fprintf(f, ";\n");
+        }
+    }
+    fprintf(f, "\n");
+}
+
+// 'init' prints the function that runs the class body on a given 'this'
+void TranslatorVisitor::printConstructorHead(ClassSignature *cs, bool init)
+{
+    const char *sep = "";
+    if (init)
+    {
+        fprintf(f, "obj_%s init_%s(obj_%s this", cs->id, cs->id, cs->id);
+        sep = ", ";
+    }
+    else
+        fprintf(f, "obj_%s new_%s(", cs->id, cs->id);
+    for (NodeList<FormalArg *>::const_iterator it = cs->fargs->begin(); it != cs->fargs->end(); ++it)
+    {
+        fprintf(f, "%s%s %s", sep, cType((*it)->type, isNativeType((*it)->type)), (*it)->id);
+        sep = ", ";
+    }
+    fprintf(f, ")");
+}
+
+/* Declares a slot for each construction of the body that stays on the
+ * stack. Constructions of classes printed later are left on the heap */
+void TranslatorVisitor::printStackSlots(NodeList<Statement *> *stmts)
+{
+    StackSiteVisitor sites;
+    for (NodeList<Statement *>::const_iterator it = stmts->begin(); it != stmts->end(); ++it)
+    {
+        (*it)->accept(&sites);
+    }
+    for (list<ConstructorRExpr *>::const_iterator it = sites.sites.begin(); it != sites.sites.end(); ++it)
+    {
+        if (structs.count((*it)->id) == 0)
+            continue;
+        char name[32];
+        sprintf(name, "__s%d", (int) slots.size() + 1);
+        slots[*it] = name;
+        fprintf(f, "struct obj_%s_struct %s;\n", (*it)->id, name);
+        stackObjects++;
+    }
+}
+
+void TranslatorVisitor::printMethodHead(TypeNode *tn, Method *m)
+{
+    vector<bool> natives = methodNatives(tn, m->id);
+    MethodNode *mn = tn->getMethod(m->id);
+    fprintf(f, "%s %s_method_%s(obj_%s this", cType(mn->returnType, natives[0]), tn->name, m->id, tn->name);
+    int i = 1;
+    for (NodeList<FormalArg *>::const_iterator it = m->fargs->begin(); it != m->fargs->end(); ++it, ++i)
+    {
+        fprintf(f, ", %s %s", cType((*it)->type, natives[i]), (*it)->id);
+    }
+    fprintf(f, ")");
+}
+
+/* The methods of 'c' whose calls may be replaced by their body: those made
+ * of one 'return' of an expression of at most 'inlineBudget' nodes that
+ * calls no method of the program, so inlining never recurses. Getters are
+ * the common case, and become a load of the field. Calls printed before
+ * the struct of 'c' stay calls, since the C code could not read its fields */
+void TranslatorVisitor::findInlineBodies(Class *c)
+{
+    if (inlineBudget <= 0)
+        return;
+    ClassBody *cb = c->clsbdy;
+    for (NodeList<Method *>::const_iterator m = cb->meths->begin(); m != cb->meths->end(); ++m)
+    {
+        if ((*m)->stmts->size() != 1)
+            continue;
+        ReturnStatement *r = dynamic_cast<ReturnStatement*>((*m)->stmts->front());
+        if (r == NULL)
+            continue;
+        InlineSizeVisitor size;
+        r->rexpr->accept(&size);
+        if (!size.calls && size.size <= inlineBudget)
+            inlineBodies[string(c->clssig->id) + "_method_" + (*m)->id] = *m;
+    }
+}
+
+/* 'recv.m(args)' as the expression 'm' returns. The receiver and the
+ * arguments are computed first, in order, as they are for a call, and
+ * the body reads them from temporaries of the types 'm' expects */
+string TranslatorVisitor::inlinedCall(TypeNode *def, Method *m, RExpr *recv, NodeList<RExpr *> *args, vector<bool> &natives)
+{
+    inlinedCalls++;
+    unordered_map<string, string> names;
+    unordered_map<string, LocalVar> vars;
+    string cls = string("obj_") + def->name;
+    names["this"] = temp(cls.c_str(), "(" + cls + ") " + valueOf(recv, false));
+    vars["this"] = { def->name, false };
+
+    int i = 1;
+    NodeList<FormalArg *>::const_iterator farg = m->fargs->begin();
+    for (NodeList<RExpr *>::const_iterator it = args->begin(); it != args->end(); ++it, ++farg, ++i)
+    {
+        string type = cType((*farg)->type, natives[i]);
+        string value = valueOf(*it, natives[i]);
+        names[(*farg)->id] = temp(type.c_str(), natives[i] ? value : "(" + type + ") " + value);
+        vars[(*farg)->id] = { (*farg)->type, natives[i] };
+    }
+
+    unordered_map<string, string> outer = renames;
+    renames = names;
+    scopes.push_back(vars);
+    ReturnStatement *r = (ReturnStatement *) m->stmts->front();
+    string value = valueOf(r->rexpr, natives[0]);
+    scopes.pop_back();
+    renames = outer;
+
+    if (natives[0])
+        return value;
+    // The body may return a subclass of the declared type
+    return "((" + string(cType(def->getMethod(m->id)->returnType, false)) + ") " + value + ")";
+}
+
+// Name of the function every receiver of static type 'tn' runs for
+// 'method', or "" when subclasses of 'tn' override it
+string TranslatorVisitor::directCall(TypeNode *tn, const char *method)
+{
+    string key = string(tn->name) + "." + method;
+    auto known = implementations.find(key);
+    if (known != implementations.end())
+        return known->second;
+
+    string impl;
+    if (isBuiltin(tn->name))
+    {
+        for (int i = 0; i < (int) (sizeof(builtinMethods) / sizeof(builtinMethods[0])); i++)
+        {
+            if (strcmp(builtinMethods[i][0], tn->name) == 0 && strcmp(builtinMethods[i][1], method) == 0 && tn->children.empty())
+                impl = builtinMethods[i][2];
+        }
+        implementations.insert({key, impl});
+        return impl;
+    }
+
+    // Any override below 'tn' makes the call dynamic
+    TypeNode *def = tn->implementation((char*)method);
+    if (def != NULL)
+        impl = string(def->name) + "_method_" + method;
+    implementations.insert({key, impl});
+    return impl;
+}
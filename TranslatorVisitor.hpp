@@ -14,13 +14,24 @@
 #include "stdio.h"
 
 #include <unordered_map>
+#include <unordered_set>
 #include <string>
+#include <vector>
 
 #include "visitors.hpp"
 #include "TypeTree.hpp"
 
 using std::unordered_map;
+using std::unordered_set;
 using std::string;
+using std::vector;
+
+/* A variable as declared in the generated C code */
+struct LocalVar
+{
+    char *type;     // Quack type, interned
+    bool native;    // held as a C int/bool rather than an object
+};
 
 class TranslatorVisitor : public Visitor 
 {
@@ -30,18 +41,95 @@ class TranslatorVisitor : public Visitor
         TypeTree *tt;
         SymbolTable *st;
 
-        list<string> printed;
-        list<string> methodPrinted;
-
         char *className;
         unordered_map<string, string> classMethods;
+        unordered_map<string, ClassSignature *> signatures;
+
+        // Variables declared so far, innermost block last
+        vector<unordered_map<string, LocalVar> > scopes;
+        char *returnType;   // of the method being printed
+        bool nativeReturn;
+        Method *method;     // being printed, NULL outside methods
+        size_t methodScope; // its entry in 'scopes'
 
-        bool inMethod;
+        // Literals of the program, printed once as static objects
+        unordered_map<int, string> intLiterals;
+        unordered_map<string, string> strLiterals;
+        void printLiterals(Program *);
+        int frames; // nested shadow stack frames printed so far
 
         IdentNode *isIdent(RExpr *);
         ObjectFieldLExpr *isOFL(RExpr *);
-        char *getType(RExpr *);
         void printRExpr(RExpr *);
+        void printLocalVariables(SymbolTable *, list<string> *);
+        void declare(char *, char *, bool);
+        LocalVar *lookup(char *);
+
+        // Unboxing: which values are held as C ints and bools
+        unordered_map<string, vector<bool> > families;
+        bool isValueType(char *);
+        bool isNativeType(char *);
+        bool isNative(RExpr *);
+        bool nativeOperator(BinaryOperatorNode *);
+        vector<bool> methodNatives(TypeNode *, char *);
+        const char *cType(char *, bool);
+        const char *resultType(RExpr *);
+
+        // Expressions are lowered to A-normal form: visiting one leaves
+        // its C expression in 'result', after adding the temporaries it
+        // needs to 'prelude'. Each subexpression is evaluated once
+        string result;
+        string prelude;
+        int temps;      // temporaries declared so far
+        int elses;      // else blocks opened by the elifs of an if
+        string valueOf(RExpr *, bool);
+        string valueAs(RExpr *, char *, bool);
+        string conditionOf(RExpr *);
+        string atomOf(RExpr *);
+        string callOf(RExpr *, const char *, NodeList<RExpr *> *);
+        string temp(const char *, string);
+        void printPrelude();
+
+        // Declarations of every class, constructor and method, printed
+        // before any code so calls may refer to classes defined later
+        void printDeclarations(Program *);
+        void printConstructorHead(ClassSignature *, bool);
+        void printMethodHead(TypeNode *, Method *);
+
+        // Class hierarchy analysis: the one implementation a call can reach
+        unordered_map<string, string> implementations;
+        string directCall(TypeNode *, const char *);
+
+        // Self tail calls: 'return r.m(...)' in method m, where the call can
+        // only reach m itself, rebinds 'this' and the arguments and jumps
+        // back to the start of the method
+        bool isSelfCall(RExpr *);
+        bool hasSelfTailCall(NodeList<Statement *> *);
+        void printTailCall(DotRExpr *);
+
+        // Inlining: a direct call of a method whose body is one small
+        // 'return' calling no other method of the program is replaced by
+        // that expression, with 'this' and the arguments in temporaries
+        unordered_map<string, Method *> inlineBodies; // by implementation
+        unordered_map<string, string> renames;        // variables of the inlined body
+        void findInlineBodies(Class *);
+        string inlinedCall(TypeNode *, Method *, RExpr *, NodeList<RExpr *> *, vector<bool> &);
+
+        // Objects that do not escape (EscapeVisitor) live in a slot of the
+        // C function, initialized by 'init_<Class>' in place of 'new_<Class>'.
+        // A slot needs the class's struct, printed with its class
+        unordered_map<ConstructorRExpr *, string> slots;
+        unordered_set<string> structs; // classes whose struct is printed
+        void printStackSlots(NodeList<Statement *> *);
+
+        // Switches on the receiver's class at the dynamic call sites, over
+        // at most 'switchSize' implementations each
+        static const int switchSize = 4;
+        string switchCall(TypeNode *, const char *, string, string, string);
+
+        void printFrame(list<string> *, char *);
+        void printStatement(Statement *);
+        void printBlock(SymbolTable *, NodeList<Statement *> *);
 
         // Given a TypeNode, print it's methods
         void printMethodSignatures(TypeNode *);
@@ -49,6 +137,14 @@ class TranslatorVisitor : public Visitor
 
     public:
         FILE *f = NULL;
+        bool unbox = true; // emit Int and Boolean values as C ints where types allow
+        int callSites = 0;
+        int directCalls = 0; // call sites compiled to a direct call
+        int switchedCalls = 0; // call sites given a switch on the receiver's class
+        int tailCalls = 0;   // self tail calls turned into jumps
+        int inlineBudget = 16; // nodes an inlined expression may have, 0 for none
+        int inlinedCalls = 0;  // call sites replaced by the method body
+        int stackObjects = 0;  // constructions given a stack slot
 
         TranslatorVisitor(char *, TypeTree *, SymbolTable *);
        ~TranslatorVisitor(); 
@@ -60,15 +156,16 @@ class TranslatorVisitor : public Visitor
         void visitClassBody(ClassBody *);
         void visitFormalArg(FormalArg *);
         void visitMethod(Method *);
-        void visitTrueIdentOption(TrueIdentOption *);
-        void visitFalseIdentOption(FalseIdentOption *);
         void visitAssignmentStatement(AssignmentStatement *);
         void visitReturnStatement(ReturnStatement *);
+        void visitRExprStatement(RExprStatement *);
+        void visitIfBlock(IfBlock *);
         void visitIfClause(IfClause *);
         void visitElifClause(ElifClause *);
         void visitTrueElseOption(TrueElseOption *);
         void visitWhileStatement(WhileStatement *);
         void visitConstructorRExpr(ConstructorRExpr *);
+        void visitEmptyRExpr(EmptyRExpr *);
         void visitIntNode(IntNode *);
         void visitStringNode(StringNode *);
         void visitNotNode(NotNode *);
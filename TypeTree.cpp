@@ -15,6 +15,7 @@
 #include "string.h"
 
 #include "TypeTree.hpp"
+#include "util.hpp"
 
 using std::list;
 
@@ -24,86 +25,88 @@ using std::list;
  * */
 TypeTree::TypeTree()
 {
-    OBJ     = strdup((char*)"Obj");
-    INT     = strdup((char*)"Int");
-    STR     = strdup((char*)"String");
-    BOOL    = strdup((char*)"Boolean");
-    NOTHING = strdup((char*)"Nothing");
+    OBJ     = NAME_OBJ;
+    INT     = NAME_INT;
+    STR     = NAME_STRING;
+    BOOL    = NAME_BOOLEAN;
+    NOTHING = NAME_NOTHING;
 
     TypeNode *o = new TypeNode(OBJ, NULL);
     root = o;
+    index.insert({OBJ, o});
+    numbered = false;
+    methodsFlat = false;
+    fieldsFlat = false;
+    changes = 0;
+    memset(lcaMemo, 0, sizeof(lcaMemo));
 
     list<char*> emptyArgs;
 
     // Assigning build-in methods of Obj to TypeTree
     list<char*> objArgs;
     objArgs.push_back(OBJ);
-    MethodNode *m = new MethodNode(strdup((char*)"STR"), emptyArgs, STR);
+    MethodNode *m = new MethodNode(intern("STR"), emptyArgs, STR);
     this->addMethodToType(OBJ, m);
-    MethodNode *ObjPrint = new MethodNode(strdup((char*)"PRINT"), emptyArgs, NOTHING);
+    MethodNode *ObjPrint = new MethodNode(intern("PRINT"), emptyArgs, NOTHING);
     this->addMethodToType(OBJ, ObjPrint); 
-    MethodNode *ObjEquals = new MethodNode(strdup((char*)"EQUALS"), objArgs, BOOL);
+    MethodNode *ObjEquals = new MethodNode(intern("EQUALS"), objArgs, BOOL);
     this->addMethodToType(OBJ, ObjEquals);
 
+    // The builtin classes are added first: Int, String, Boolean, Nothing
+
     // Assignment built-in methods of Int to TypeTree
-    root->addChild(INT);
+    this->addSubtype(INT, OBJ);
     list<char*> int_args;
     int_args.push_back(INT);
-    MethodNode *IntPlus = new MethodNode(strdup((char*)"PLUS"), int_args, INT);
+    MethodNode *IntPlus = new MethodNode(intern("PLUS"), int_args, INT);
     this->addMethodToType(INT, IntPlus);
-    MethodNode *IntMinus = new MethodNode(strdup((char*)"MINUS"), int_args, INT);
+    MethodNode *IntMinus = new MethodNode(intern("MINUS"), int_args, INT);
     this->addMethodToType(INT, IntMinus);
-    MethodNode *IntTimes = new MethodNode(strdup((char*)"TIMES"), int_args, INT);
+    MethodNode *IntTimes = new MethodNode(intern("TIMES"), int_args, INT);
     this->addMethodToType(INT, IntTimes);
-    MethodNode *IntDivide = new MethodNode(strdup((char*)"DIVIDE"), int_args, INT);
+    MethodNode *IntDivide = new MethodNode(intern("DIVIDE"), int_args, INT);
     this->addMethodToType(INT, IntDivide);
-    MethodNode *IntAtMost = new MethodNode(strdup((char*)"ATMOST"), int_args, BOOL);
+    MethodNode *IntAtMost = new MethodNode(intern("ATMOST"), int_args, BOOL);
     this->addMethodToType(INT, IntAtMost);
-    MethodNode *IntLess = new MethodNode(strdup((char*)"LESS"), int_args, BOOL);
+    MethodNode *IntLess = new MethodNode(intern("LESS"), int_args, BOOL);
     this->addMethodToType(INT, IntLess);
-    MethodNode *IntAtLeast = new MethodNode(strdup((char*)"ATLEAST"), int_args, BOOL);
+    MethodNode *IntAtLeast = new MethodNode(intern("ATLEAST"), int_args, BOOL);
     this->addMethodToType(INT, IntAtLeast);
-    MethodNode *IntMore = new MethodNode(strdup((char*)"MORE"), int_args, BOOL);
+    MethodNode *IntMore = new MethodNode(intern("MORE"), int_args, BOOL);
     this->addMethodToType(INT, IntMore);
 
     // Methods for String
-    root->addChild(STR);
+    this->addSubtype(STR, OBJ);
     list<char*> str_args;
     str_args.push_back(STR);
-    MethodNode *StrPlus = new MethodNode(strdup((char*)"PLUS"), str_args, STR);
+    MethodNode *StrPlus = new MethodNode(intern("PLUS"), str_args, STR);
     this->addMethodToType(STR, StrPlus);
-    MethodNode *StrAtMost = new MethodNode(strdup((char*)"ATMOST"), str_args, BOOL);
+    MethodNode *StrAtMost = new MethodNode(intern("ATMOST"), str_args, BOOL);
     this->addMethodToType(STR, StrAtMost);
-    MethodNode *StrLess = new MethodNode(strdup((char*)"LESS"), str_args, BOOL);
+    MethodNode *StrLess = new MethodNode(intern("LESS"), str_args, BOOL);
     this->addMethodToType(STR, StrLess);
-    MethodNode *StrAtLeast = new MethodNode(strdup((char*)"ATLEAST"), str_args, BOOL);
+    MethodNode *StrAtLeast = new MethodNode(intern("ATLEAST"), str_args, BOOL);
     this->addMethodToType(STR, StrAtLeast);
-    MethodNode *StrMore = new MethodNode(strdup((char*)"MORE"), str_args, BOOL);
+    MethodNode *StrMore = new MethodNode(intern("MORE"), str_args, BOOL);
     this->addMethodToType(STR, StrMore);
 
     // Methods for Bool
-    root->addChild(BOOL);
+    this->addSubtype(BOOL, OBJ);
     list<char*> bool_args;
     bool_args.push_back(BOOL);
-    MethodNode *BoolNot = new MethodNode(strdup((char*)"NOT"), bool_args, BOOL);
+    MethodNode *BoolNot = new MethodNode(intern("NOT"), bool_args, BOOL);
     this->addMethodToType(BOOL, BoolNot);
-    MethodNode *BoolAnd = new MethodNode(strdup((char*)"AND"), bool_args, BOOL);
+    MethodNode *BoolAnd = new MethodNode(intern("AND"), bool_args, BOOL);
     this->addMethodToType(BOOL, BoolAnd);
-    MethodNode *BoolOr  = new MethodNode(strdup((char*)"OR" ), bool_args, BOOL);
+    MethodNode *BoolOr  = new MethodNode(intern("OR"), bool_args, BOOL);
     this->addMethodToType(BOOL, BoolOr);
 
     // No methods for 'Nothing' type
-    root->addChild(NOTHING);
+    this->addSubtype(NOTHING, OBJ);
 }
 
 TypeTree::~TypeTree()
 {
-    free(OBJ);
-    free(INT);
-    free(STR);
-    free(BOOL);
-    free(NOTHING);
-    
     delete root;
 }
 
@@ -114,6 +117,11 @@ bool TypeTree::addSubtype(TypeNode *sub, char *super)
         return false;
 
     type->addChild(sub);
+    index.insert({sub->name, sub}); // a redefinition keeps the first
+    numbered = false;
+    methodsFlat = false;
+    fieldsFlat = false;
+    changes++;
     return true;
 }
 
@@ -130,6 +138,8 @@ bool TypeTree::addMethodToType(char *_type, MethodNode *m)
         return false;
 
     type->addMethod(m);
+    methodsFlat = false;
+    changes++;
     return true;
 }
 
@@ -140,6 +150,8 @@ bool TypeTree::addVarToType(char *type, VariableNode *v)
         return false;
 
     t->addInstanceVar(v, this);
+    fieldsFlat = false;
+    changes++;
     return true;
 }
 
@@ -152,7 +164,7 @@ bool TypeTree::isSubtype(char *_t1, char *_t2)
     if (t1 == NULL || t2 == NULL)
         return false;
 
-    return t2->hasDescendant(_t1);
+    return below(t1, t2);
 }
 
 
@@ -165,7 +177,143 @@ bool TypeTree::isSupertype(char *_t1, char *_t2)
     if (t1 == NULL || t2 == NULL)
         return false;
 
-    return t1->hasDescendant(_t2); 
+    return below(t2, t1); 
+}
+
+/* Is 't' a (direct or indirect) subtype of 'ancestor'? Its preorder
+ * number falls inside the ancestor's subtree
+ * */
+bool TypeTree::below(TypeNode *t, TypeNode *ancestor)
+{
+    if (!numbered)
+        number();
+    return ancestor->pre < t->pre && t->pre <= ancestor->last;
+}
+
+/* Number the TypeNodes in preorder, children in the order they were
+ * added. The loop keeps its own stack: hierarchies can be deep
+ * */
+void TypeTree::number()
+{
+    vector<TypeNode *> &order = preorder;
+    vector<TypeNode *> work;
+    order.clear();
+    work.push_back(root);
+    while (!work.empty())
+    {
+        TypeNode *t = work.back();
+        work.pop_back();
+        t->pre = (int) order.size();
+        order.push_back(t);
+
+        // The parent has its table already: preorder visits it first
+        t->up.clear();
+        if (t->parent == NULL)
+            t->depth = 0;
+        else
+        {
+            t->depth = t->parent->depth + 1;
+            t->up.push_back(t->parent);
+            for (size_t k = 0; k < t->up[k]->up.size(); k++)
+                t->up.push_back(t->up[k]->up[k]);
+        }
+        for (list<TypeNode *>::const_reverse_iterator it = t->children.rbegin(); it != t->children.rend(); ++it)
+        {
+            work.push_back(*it);
+        }
+    }
+    // Children come after their parent, so walking backwards
+    // finishes every subtree before the node above it
+    for (vector<TypeNode *>::const_reverse_iterator it = order.rbegin(); it != order.rend(); ++it)
+    {
+        TypeNode *t = *it;
+        t->last = t->pre;
+        for (list<TypeNode *>::const_iterator c = t->children.begin(); c != t->children.end(); ++c)
+        {
+            if ((*c)->last > t->last)
+                t->last = (*c)->last;
+        }
+    }
+    memset(lcaMemo, 0, sizeof(lcaMemo));
+    numbered = true;
+}
+
+void TypeTree::flatten()
+{
+    if (!methodsFlat)
+        flattenMethods();
+    if (!fieldsFlat)
+        flattenFields();
+}
+
+/* Each class starts from a copy of its parent's method table, which
+ * preorder has already built. An override takes over the parent's
+ * slot; a new method gets the next one
+ * */
+void TypeTree::flattenMethods()
+{
+    if (!numbered)
+        number();
+    for (vector<TypeNode *>::const_iterator it = preorder.begin(); it != preorder.end(); ++it)
+    {
+        TypeNode *t = *it;
+        t->methodTable.clear();
+        t->methodSlots.clear();
+        if (t->parent != NULL)
+        {
+            t->methodTable = t->parent->methodTable;
+            t->methodSlots = t->parent->methodSlots;
+        }
+        for (list<MethodNode *>::const_iterator m = t->methods.begin(); m != t->methods.end(); ++m)
+        {
+            auto slot = t->methodSlots.find((*m)->id);
+            if (slot == t->methodSlots.end())
+            {
+                t->methodSlots.insert({(*m)->id, (int) t->methodTable.size()});
+                t->methodTable.push_back({*m, t, t});
+            }
+            else if (t->methodTable[slot->second].owner != t) // a second definition is ignored
+            {
+                t->methodTable[slot->second].method = *m;
+                t->methodTable[slot->second].owner = t;
+            }
+        }
+    }
+    methodsFlat = true;
+}
+
+/* Fields are laid out like methods. A field this class sets again
+ * keeps the parent's slot, with this class's type
+ * */
+void TypeTree::flattenFields()
+{
+    if (!numbered)
+        number();
+    for (vector<TypeNode *>::const_iterator it = preorder.begin(); it != preorder.end(); ++it)
+    {
+        TypeNode *t = *it;
+        t->fieldTable.clear();
+        t->fieldSlots.clear();
+        if (t->parent != NULL)
+        {
+            t->fieldTable = t->parent->fieldTable;
+            t->fieldSlots = t->parent->fieldSlots;
+        }
+        for (list<VariableNode *>::const_iterator v = t->instanceVars.begin(); v != t->instanceVars.end(); ++v)
+        {
+            auto slot = t->fieldSlots.find((*v)->name);
+            if (slot == t->fieldSlots.end())
+            {
+                t->fieldSlots.insert({(*v)->name, (int) t->fieldTable.size()});
+                t->fieldTable.push_back(*v);
+            }
+            else
+            {
+                t->fieldTable[slot->second] = *v;
+            }
+        }
+    }
+    fieldsFlat = true;
 }
 
 /* Find the name of the least common ancestor between two types
@@ -177,24 +325,46 @@ char *TypeTree::LCA(char *_t1, char *_t2)
     if (t1 == NULL || t2 == NULL)
         return NULL;
 
-    TypeNode *t2origin = t2;
+    return lca(t1, t2)->name;
+}
 
-    if (t1->equals(t2))
-        return t1->name;
+/* The least common ancestor of two TypeNodes. Lifts 't1' up by
+ * halving jumps to the highest ancestor that is not above 't2': its
+ * parent is the answer. Takes O(log depth) steps, and recent answers
+ * are kept in lcaMemo
+ * */
+TypeNode *TypeTree::lca(TypeNode *t1, TypeNode *t2)
+{
+    if (t1 == t2)
+        return t1;
+    if (!numbered)
+        number();
+
+    if (t1->pre > t2->pre) // LCA(a, b) == LCA(b, a): keep one entry
+    {
+        TypeNode *t = t1;
+        t1 = t2;
+        t2 = t;
+    }
+    LCAMemo &memo = lcaMemo[(unsigned) (t1->pre * 31 + t2->pre) % lcaMemoSize];
+    if (memo.t1 == t1 && memo.t2 == t2)
+        return memo.lca;
 
-    while (strcmp(t1->name, (char*)"Obj") != 0)
+    TypeNode *a = t1;
+    if (!below(t2, a))
     {
-        while (strcmp(t2->name, (char*)"Obj") != 0)
+        for (int k = (int) a->up.size() - 1; k >= 0; k--)
         {
-            if (t1->equals(t2))
-                return t1->name;
-            t2 = t2->parent;
+            if (k < (int) a->up.size() && !below(t2, a->up[k]))
+                a = a->up[k];
         }
-        t1 = t1->parent;
-        t2 = t2origin;
+        a = a->parent;
     }
 
-    return this->root->name; //The top level ancestor
+    memo.t1 = t1;
+    memo.t2 = t2;
+    memo.lca = a;
+    return a;
 }
 
 /* Does '_type' have a method named 'method'?
@@ -204,6 +374,8 @@ bool TypeTree::typeHasMethod(char *_type, char *method)
     TypeNode *type = findType(_type);
     if (type == NULL)
         return false;
+    if (!methodsFlat)
+        flattenMethods();
     return type->hasMethod(method);
 }
 
@@ -230,6 +402,8 @@ MethodNode *TypeTree::typeGetMethod(char *_type, char *method)
     TypeNode *type = findType(_type);
     if (type == NULL)
         return NULL;
+    if (!methodsFlat)
+        flattenMethods();
     return type->getMethod(method);
 }
 
@@ -238,7 +412,10 @@ MethodNode *TypeTree::typeGetMethod(char *_type, char *method)
  * */
 TypeNode *TypeTree::findType(char *name)
 {
-    return search(root, name);
+    auto found = index.find(name);
+    if (found == index.end())
+        return NULL;
+    return found->second;
 }
 
 /* Recursively searches the TypeTree for a TypeNode named 'name'
@@ -275,7 +452,7 @@ void TypeTree::print(TypeNode *t)
 
 
 /******** TypeNode methods ********/
-TypeNode::TypeNode(char *n, TypeNode *p) : name(n), parent(p) {}
+TypeNode::TypeNode(char *n, TypeNode *p) : name(n), parent(p), pre(-1), last(-1), depth(-1) {}
 
 TypeNode::~TypeNode()
 {
@@ -290,12 +467,7 @@ TypeNode::~TypeNode()
 
 bool TypeNode::hasInstanceVar(char *name)
 {
-    for (list<VariableNode*>::const_iterator it = instanceVars.begin(); it != instanceVars.end(); ++it)
-    {
-        if (strcmp((*it)->name, name) == 0)
-            return true;
-    }
-    return false;
+    return instanceVarIndex.count(name) > 0;
 }
 
 //NOTE: Has no way of knowing if this variable should be trashed
@@ -311,17 +483,19 @@ void TypeNode::addInstanceVar(VariableNode *v, TypeTree *tt)
     else 
     {
         instanceVars.push_back(v);
+        instanceVarIndex.insert({v->name, v});
     }
 }
 
+/* Instance variables set by this class's own constructor: Quack does
+ * not let a class use the fields of its parent that it does not set
+ * */
 VariableNode *TypeNode::getInstanceVar(char *name)
 {
-    for (list<VariableNode*>::const_iterator it = instanceVars.begin(); it != instanceVars.end(); ++it)
-    {
-        if (strcmp((*it)->name, name) == 0)
-            return (*it);
-    }
-    return NULL;
+    auto found = instanceVarIndex.find(name);
+    if (found == instanceVarIndex.end())
+        return NULL;
+    return found->second;
 }
 
 
@@ -343,7 +517,7 @@ bool TypeNode::hasDescendant(char *type)
 {
     for (list<TypeNode*>::const_iterator it = children.begin(); it != children.end(); ++it)
     {
-        if (strcmp((*it)->name, type) == 0 || (*it)->hasDescendant(type))
+        if ((*it)->name == type || (*it)->hasDescendant(type))
             return true;
     }
     return false;
@@ -354,41 +528,65 @@ void TypeNode::addMethod(MethodNode *m)
     methods.push_back(m);
 }
 
+/* The method lookups below use the method table, so TypeTree::flatten
+ * must have run since the last method or class was added
+ * */
 bool TypeNode::hasMethod(char *name)
 {
-    for (list<MethodNode *>::const_iterator it = this->methods.begin(); it != this->methods.end(); ++it)
-    {
-        if ( strcmp((*it)->id, name) == 0)
-            return true;
-    }
-    if (this->parent != NULL)
-        return parent->hasMethod(name);
-
-    return false;
+    return methodSlots.count(name) > 0;
 }
 
 MethodNode *TypeNode::getMethod(char *name)
 {
-    for (list<MethodNode *>::const_iterator it = this->methods.begin(); it != this->methods.end(); ++it)
-    {
-        if ( strcmp((*it)->id, name) == 0)
-            return (*it);
-    }
-    if (this->parent != NULL) //follow inheritance tree
+    auto slot = methodSlots.find(name);
+    if (slot == methodSlots.end())
+        return NULL;
+    return methodTable[slot->second].method;
+}
+
+/* The class whose definition of 'name' this class runs */
+TypeNode *TypeNode::methodOwner(char *name)
+{
+    auto slot = methodSlots.find(name);
+    if (slot == methodSlots.end())
+        return NULL;
+    return methodTable[slot->second].owner;
+}
+
+/* The class whose definition of 'name' every call on this static type
+ * runs (class hierarchy analysis), or NULL when a class below overrides it */
+TypeNode *TypeNode::implementation(char *name)
+{
+    TypeNode *def = methodOwner(name);
+    list<TypeNode *> work(children.begin(), children.end());
+    while (!work.empty() && def != NULL)
     {
-        return parent->getMethod(name);
+        TypeNode *t = work.front();
+        work.pop_front();
+        if (t->methodOwner(name) == t)
+            def = NULL;
+        work.insert(work.end(), t->children.begin(), t->children.end());
     }
-    return NULL;
+    return def;
+}
+
+/* The topmost class defining 'name', which added its slot */
+TypeNode *TypeNode::methodOrigin(char *name)
+{
+    auto slot = methodSlots.find(name);
+    if (slot == methodSlots.end())
+        return NULL;
+    return methodTable[slot->second].origin;
 }
 
 int TypeNode::equals(TypeNode *type)
 {
-    return strcmp(this->name, type->name) == 0;
+    return this->name == type->name;
 }
 
 int TypeNode::equals(char *n)
 {
-    return strcmp(this->name, n) == 0;
+    return this->name == n;
 }
 
 void TypeNode::print()
@@ -405,10 +603,7 @@ void TypeNode::print()
 
 MethodNode::MethodNode(char *i, list<char*> a, char *r) : id(i), argsType(a), returnType(r) {}
 
-MethodNode::~MethodNode()
-{
-    free(id);    
-}
+MethodNode::~MethodNode() {}
 
 void MethodNode::print()
 {
@@ -422,15 +617,15 @@ void MethodNode::print()
 
 bool MethodNode::equals(MethodNode *m)
 {
-    if (strcmp(m->id, id) == 0)
+    if (m->id == id)
     {
-        if (strcmp(m->returnType, returnType) == 0)
+        if (m->returnType == returnType)
         {
             list<char*>::iterator it1 = m->argsType.begin();
             list<char*>::iterator it2 = argsType.begin();
             while (it1 != m->argsType.end() && it2 != argsType.end())
             {
-                if (strcmp((*it1), (*it2)) != 0)
+                if ((*it1) != (*it2))
                     return false;
                 ++it1;
                 ++it2;
@@ -11,8 +11,14 @@
 #define TYPE_H
 
 #include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 using std::list;
+using std::string;
+using std::unordered_map;
+using std::vector;
 
 
 /* Classes defined in this file */
@@ -20,6 +26,7 @@ class MethodNode;
 class VariableNode;
 class TypeNode;
 class TypeTree;
+struct MethodSlot;
 
 
 /* Class definitions */
@@ -28,6 +35,26 @@ class TypeTree
 {
     private:
         TypeNode *root;
+        unordered_map<char *, TypeNode *> index; // every TypeNode, by (interned) name
+
+        // Subtype tests compare preorder numbers, which are given out
+        // again after the hierarchy changes
+        bool numbered;
+        bool below(TypeNode *t, TypeNode *ancestor);
+        vector<TypeNode *> preorder; // every TypeNode, parents first
+
+        // The flattened method and field tables of the TypeNodes are
+        // built again after the hierarchy, methods or fields change
+        bool methodsFlat;
+        bool fieldsFlat;
+        void flattenMethods();
+        void flattenFields();
+
+        // Recent LCA answers, indexed by a hash of the two TypeNodes.
+        // Emptied whenever the TypeNodes are numbered again
+        static const int lcaMemoSize = 256;
+        struct LCAMemo { TypeNode *t1, *t2, *lca; } lcaMemo[lcaMemoSize];
+        TypeNode *lca(TypeNode *t1, TypeNode *t2);
 
         char *OBJ;
         char *INT;
@@ -35,6 +62,9 @@ class TypeTree
         char *BOOL;
         char *NOTHING;
     public:
+        // Bumped whenever a type, method or field is added
+        unsigned long changes;
+
         TypeTree();
         ~TypeTree();
 
@@ -46,6 +76,13 @@ class TypeTree
         bool isSubtype(char *_t1, char *_t2);
         bool isSupertype(char *_t1, char *_t2);
 
+        /* Give every TypeNode its preorder numbers (pre, last), depth
+         * and ancestor table (up) */
+        void number();
+
+        /* Build every TypeNode's methodTable and fieldTable */
+        void flatten();
+
         /* Find least common ancestor between two types */
         char *LCA(char *_t1, char *_t2);
 
@@ -60,6 +97,16 @@ class TypeTree
         void print(TypeNode *t);
 };
 
+/* Specifies an entry of a TypeNode's method table: the method the class
+ * runs, the class that defines it, and the class that added the slot
+ * */
+struct MethodSlot
+{
+    MethodNode *method;
+    TypeNode *owner;
+    TypeNode *origin;
+};
+
 /* Specifies a node of the TypeTree that represents a class/type,
  * which includes information about its variables and methods
  *
@@ -71,8 +118,28 @@ class TypeNode
         char *name;
         TypeNode *parent;
         list<TypeNode *>     children;
-        list<MethodNode *>   methods;
-        list<VariableNode *> instanceVars;
+        list<MethodNode *>   methods;      // defined in this class
+        list<VariableNode *> instanceVars; // set by this class's constructor
+        unordered_map<char *, VariableNode *> instanceVarIndex;
+
+        // Every method and field of the class, inherited ones included,
+        // in the order of the C structs: the slots of the parent come
+        // first, in the parent's order, then the ones this class adds.
+        // Built by TypeTree::flatten. Keyed by interned name
+        vector<MethodSlot> methodTable;
+        unordered_map<char *, int> methodSlots;
+        vector<VariableNode *> fieldTable;
+        unordered_map<char *, int> fieldSlots;
+
+        // Preorder number, and the last number in this subtree: the
+        // subtypes are numbered pre+1 .. last. Set by TypeTree::number
+        int pre;
+        int last;
+
+        // Distance from Obj, and the ancestors 1, 2, 4, 8... levels up
+        // (up[k] is 2^k levels up). Also set by TypeTree::number
+        int depth;
+        vector<TypeNode *> up;
 
         TypeNode(char *n, TypeNode *p);
        ~TypeNode();
@@ -87,6 +154,9 @@ class TypeNode
         bool hasInstanceVar(char *name);
 
         MethodNode *getMethod(char *name);
+        TypeNode *methodOwner(char *name);
+        TypeNode *methodOrigin(char *name);
+        TypeNode *implementation(char *name);
         VariableNode *getInstanceVar(char *name);
 
         int equals(TypeNode *type);
@@ -0,0 +1,50 @@
+#!/bin/bash
+# Compile-time benchmark for qc: writes a program with many classes to
+# bench_classes.qk and times compiling it.
+#
+# Usage: bench/classes.sh [classes] [depth] [cross]
+#   classes  how many classes to generate (default 10000)
+#   depth    length of each chain of subclasses (default 1: every class
+#            extends Base directly)
+#   cross    1 to also join each class with the class at the same depth
+#            in the chain before it, whose common ancestor is Base
+#            (default 0)
+#
+# Every class has a field and a method that overrides its parent's.
+# The main program builds an object of each class and joins them in
+# one variable, so the type checker looks up, compares and joins every
+# class. Only qc itself is timed (-S): gcc is not run on the output.
+# Run it from the directory holding qc.
+
+classes=${1:-10000}
+depth=${2:-1}
+cross=${3:-0}
+file=bench_classes.qk
+
+awk -v n="$classes" -v d="$depth" -v c="$cross" 'BEGIN {
+    printf "class Base(v: Int) {\n    this.v = v;\n"
+    printf "    def get(): Int {\n        return this.v;\n    }\n}\n\n"
+    for (i = 0; i < n; i++) {
+        if (i % d == 0)
+            printf "class C%d(v: Int) extends Base {\n", i
+        else
+            printf "class C%d(v: Int) extends C%d {\n", i, i - 1
+        printf "    this.v = v;\n"
+        printf "    def get(): Int {\n        return this.v + %d;\n    }\n}\n\n", i
+    }
+    printf "x = Base(0);\n"
+    printf "total = 0;\n"
+    for (i = 0; i < n; i++) {
+        printf "x = C%d(%d);\n", i, i
+        printf "total = total + x.get();\n"
+    }
+    for (i = d; c && i < n; i++) {
+        printf "y%d = C%d(0);\n", i, i
+        printf "y%d = C%d(0);\n", i, i - d
+        printf "total = total + y%d.get();\n", i
+    }
+    printf "total.PRINT();\n"
+}' > $file
+
+echo "$classes classes, chains of $depth$([ "$cross" = 1 ] && echo ", joined across chains")"
+time ./qc -S $file > /dev/null 2>&1
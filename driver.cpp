@@ -8,9 +8,12 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <list>
 #include <iostream>
 
+#include "ConstantFoldVisitor.hpp"
+#include "EscapeVisitor.hpp"
 #include "TranslatorVisitor.hpp"
 #include "TypeTree.hpp"
 #include "visitors.hpp"
@@ -26,13 +29,40 @@ extern Program *root;
 
 int main(int argc, char* argv[])
 {
-    if (argc != 2)
+    // Options come before the file name
+    bool unbox = true;
+    bool stats = false;
+    bool onlyC = false; // stop once q.c is written
+    bool stack = true;  // objects that do not escape go on the stack
+    int inlineBudget = -1; // the TranslatorVisitor's own unless given
+    char *filename = NULL;
+    for (int i = 1; i < argc; i++)
     {
-        fprintf(stderr, "Usage: %s filename\n", argv[0]);
+        if (strcmp(argv[i], "-no-unbox") == 0)
+            unbox = false;
+        else if (strcmp(argv[i], "-stats") == 0)
+            stats = true;
+        else if (strcmp(argv[i], "-S") == 0)
+            onlyC = true;
+        else if (strcmp(argv[i], "-no-stack") == 0)
+            stack = false;
+        else if (strncmp(argv[i], "-inline=", 8) == 0)
+            inlineBudget = atoi(argv[i] + 8);
+        else if (argv[i][0] == '-' || filename != NULL)
+        {
+            filename = NULL; // unknown option or second file
+            break;
+        }
+        else
+            filename = argv[i];
+    }
+    if (filename == NULL)
+    {
+        fprintf(stderr, "Usage: %s [-no-unbox] [-no-stack] [-stats] [-S] [-inline=N] filename\n", argv[0]);
         return -1;
     }
 
-    FILE *myfile = fopen(argv[1], "r");
+    FILE *myfile = fopen(filename, "r");
     if (!myfile) 
     {
         fprintf(stderr, "I can't open file!\n");
@@ -42,7 +72,7 @@ int main(int argc, char* argv[])
     int condition;
     yyin = myfile;
 #ifdef DEBUG
-    fprintf(stderr, "Beginning parse of %s\n", argv[1]);
+    fprintf(stderr, "Beginning parse of %s\n", filename);
 #endif
     
     // Parse the file, performing lexical and syntax analysis
@@ -91,14 +121,38 @@ int main(int argc, char* argv[])
         return -1;
     }
 
+    // Work out what is known before the program runs
+    ConstantFoldVisitor cfv;
+    root->accept(&cfv);
+    EscapeVisitor ev(tcv.tt);
+    if (stack)
+        root->accept(&ev);
+
     // Begin code generation
     TranslatorVisitor tv((char*)"q.c", tcv.tt, tcv.st);
+    tv.unbox = unbox;
+    if (inlineBudget >= 0)
+        tv.inlineBudget = inlineBudget;
     root->accept(&tv);
+    if (stats)
+    {
+        fprintf(stderr, "%d of %d call sites devirtualized\n", tv.directCalls, tv.callSites);
+        fprintf(stderr, "%d call sites given a switch on the receiver's class\n", tv.switchedCalls);
+        fprintf(stderr, "%d self tail calls turned into jumps\n", tv.tailCalls);
+        fprintf(stderr, "%d calls inlined\n", tv.inlinedCalls);
+        fprintf(stderr, "%d of %d objects allocated on the stack\n", tv.stackObjects, ev.allocations);
+        fprintf(stderr, "%d expressions folded, %d branches removed\n", cfv.folds, cfv.branches);
+    }
 
     fclose(tv.f);
-    system("gcc -c q.c");
-    system("gcc q.o Builtins.o -o pgm");
-    delete root;
+    if (onlyC)
+    {
+        astArena.release();
+        return 0;
+    }
+    system("gcc -O2 -fno-strict-aliasing -c q.c");
+    system("gcc q.o Builtins.o quack_alloc.o quack_gc.o quack_out.o -o pgm");
+    astArena.release(); // the whole AST at once
 
     return 0;
 }
@@ -1,14 +1,14 @@
-/* A Bison parser, made by GNU Bison 2.3.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
-/* Skeleton implementation for Bison's Yacc-like parsers in C
+/* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989, 1990, 2000, 2001, 2002, 2003, 2004, 2005, 2006
-   Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
-   This program is free software; you can redistribute it and/or modify
+   This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
-   the Free Software Foundation; either version 2, or (at your option)
-   any later version.
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
 
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
@@ -16,9 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program; if not, write to the Free Software
-   Foundation, Inc., 51 Franklin Street, Fifth Floor,
-   Boston, MA 02110-1301, USA.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -36,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -43,11 +45,11 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "2.3"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
@@ -55,59 +57,16 @@
 /* Pure parsers.  */
 #define YYPURE 0
 
-/* Using locations.  */
-#define YYLSP_NEEDED 1
-
-
-
-/* Tokens.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     INT_LIT = 258,
-     STRING_LIT = 259,
-     IDENT = 260,
-     CLASS = 261,
-     DEF = 262,
-     EXTENDS = 263,
-     IF = 264,
-     ELIF = 265,
-     ELSE = 266,
-     WHILE = 267,
-     RETURN = 268,
-     ATLEAST = 269,
-     ATMOST = 270,
-     EQUALS = 271,
-     AND = 272,
-     OR = 273,
-     NOT = 274
-   };
-#endif
-/* Tokens.  */
-#define INT_LIT 258
-#define STRING_LIT 259
-#define IDENT 260
-#define CLASS 261
-#define DEF 262
-#define EXTENDS 263
-#define IF 264
-#define ELIF 265
-#define ELSE 266
-#define WHILE 267
-#define RETURN 268
-#define ATLEAST 269
-#define ATMOST 270
-#define EQUALS 271
-#define AND 272
-#define OR 273
-#define NOT 274
-
-
-
-
-/* Copy the first part of user declarations.  */
+/* Push parsers.  */
+#define YYPUSH 0
+
+/* Pull parsers.  */
+#define YYPULL 1
+
+
+
+
+/* First part of user prologue.  */
 #line 1 "grammar.y"
 
 /* Author: Alexander Owen
@@ -139,110 +98,185 @@ void yyerror(const char *msg);
 
 Program *root;
 
+#line 102 "grammar.tab.c"
 
-/* Enabling traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
+#include "grammar.tab.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_INT_LIT = 3,                    /* INT_LIT  */
+  YYSYMBOL_STRING_LIT = 4,                 /* STRING_LIT  */
+  YYSYMBOL_IDENT = 5,                      /* IDENT  */
+  YYSYMBOL_CLASS = 6,                      /* CLASS  */
+  YYSYMBOL_DEF = 7,                        /* DEF  */
+  YYSYMBOL_EXTENDS = 8,                    /* EXTENDS  */
+  YYSYMBOL_IF = 9,                         /* IF  */
+  YYSYMBOL_ELIF = 10,                      /* ELIF  */
+  YYSYMBOL_ELSE = 11,                      /* ELSE  */
+  YYSYMBOL_WHILE = 12,                     /* WHILE  */
+  YYSYMBOL_RETURN = 13,                    /* RETURN  */
+  YYSYMBOL_ATLEAST = 14,                   /* ATLEAST  */
+  YYSYMBOL_ATMOST = 15,                    /* ATMOST  */
+  YYSYMBOL_EQUALS = 16,                    /* EQUALS  */
+  YYSYMBOL_AND = 17,                       /* AND  */
+  YYSYMBOL_OR = 18,                        /* OR  */
+  YYSYMBOL_NOT = 19,                       /* NOT  */
+  YYSYMBOL_20_ = 20,                       /* '<'  */
+  YYSYMBOL_21_ = 21,                       /* '>'  */
+  YYSYMBOL_22_ = 22,                       /* '='  */
+  YYSYMBOL_23_ = 23,                       /* '+'  */
+  YYSYMBOL_24_ = 24,                       /* '-'  */
+  YYSYMBOL_25_ = 25,                       /* '*'  */
+  YYSYMBOL_26_ = 26,                       /* '/'  */
+  YYSYMBOL_27_ = 27,                       /* '.'  */
+  YYSYMBOL_28_ = 28,                       /* '('  */
+  YYSYMBOL_29_ = 29,                       /* ')'  */
+  YYSYMBOL_30_ = 30,                       /* ':'  */
+  YYSYMBOL_31_ = 31,                       /* ','  */
+  YYSYMBOL_32_ = 32,                       /* '{'  */
+  YYSYMBOL_33_ = 33,                       /* '}'  */
+  YYSYMBOL_34_ = 34,                       /* ';'  */
+  YYSYMBOL_YYACCEPT = 35,                  /* $accept  */
+  YYSYMBOL_program = 36,                   /* program  */
+  YYSYMBOL_class_star = 37,                /* class_star  */
+  YYSYMBOL_class = 38,                     /* class  */
+  YYSYMBOL_class_signature = 39,           /* class_signature  */
+  YYSYMBOL_extends_option = 40,            /* extends_option  */
+  YYSYMBOL_formal_args = 41,               /* formal_args  */
+  YYSYMBOL_formal_arg = 42,                /* formal_arg  */
+  YYSYMBOL_formal_arg_list = 43,           /* formal_arg_list  */
+  YYSYMBOL_class_body = 44,                /* class_body  */
+  YYSYMBOL_method = 45,                    /* method  */
+  YYSYMBOL_method_star = 46,               /* method_star  */
+  YYSYMBOL_ident_option = 47,              /* ident_option  */
+  YYSYMBOL_statement_star = 48,            /* statement_star  */
+  YYSYMBOL_statement_block = 49,           /* statement_block  */
+  YYSYMBOL_statement = 50,                 /* statement  */
+  YYSYMBOL_if_clause = 51,                 /* if_clause  */
+  YYSYMBOL_elif_star = 52,                 /* elif_star  */
+  YYSYMBOL_elif_clause = 53,               /* elif_clause  */
+  YYSYMBOL_else_option = 54,               /* else_option  */
+  YYSYMBOL_l_expr = 55,                    /* l_expr  */
+  YYSYMBOL_r_expr = 56,                    /* r_expr  */
+  YYSYMBOL_r_expr_option = 57,             /* r_expr_option  */
+  YYSYMBOL_actual_args = 58,               /* actual_args  */
+  YYSYMBOL_actual_arg_list = 59            /* actual_arg_list  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
-/* Enabling the token table.  */
-#ifndef YYTOKEN_TABLE
-# define YYTOKEN_TABLE 0
-#endif
 
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
-#line 33 "grammar.y"
-{
-    int integer;
-    char *id;
-    std::list<Statement *> *stmts;
-    std::list<Class *>     *clsss; 
-    std::list<RExpr *> *rexprs;
-    std::list<ElifClause *> *elifs;
-    std::list<FormalArg *> *fargs;
-    std::list<Method *> *meths;
-    Class *cls;
-    ClassBody *clsbdy;
-    ClassSignature *clssig;
-    Statement *stmt;
-    Method *meth;
-    IfClause *_if;
-    ElifClause *_elif;
-    ElseOption *_else;
-    IdentOption *idop;
-    ExtendsOption *exop;
-    FormalArg *farg;
-    RExpr *rexpr;
-    LExpr *lexpr;
-    Program *pgm;
 
-}
-/* Line 193 of yacc.c.  */
-#line 191 "grammar.tab.c"
-	YYSTYPE;
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
-# define YYSTYPE_IS_DECLARED 1
-# define YYSTYPE_IS_TRIVIAL 1
-#endif
 
-#if ! defined YYLTYPE && ! defined YYLTYPE_IS_DECLARED
-typedef struct YYLTYPE
-{
-  int first_line;
-  int first_column;
-  int last_line;
-  int last_column;
-} YYLTYPE;
-# define yyltype YYLTYPE /* obsolescent; will be withdrawn */
-# define YYLTYPE_IS_DECLARED 1
-# define YYLTYPE_IS_TRIVIAL 1
+#ifdef short
+# undef short
 #endif
 
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
 
-/* Copy the second part of user declarations.  */
-
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
 
-/* Line 216 of yacc.c.  */
-#line 216 "grammar.tab.c"
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
 
-#ifdef short
-# undef short
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
-typedef unsigned char yytype_uint8;
+typedef short yytype_int16;
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
-#elif (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-typedef signed char yytype_int8;
-#else
-typedef short int yytype_int8;
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef short int yytype_int16;
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -250,55 +284,106 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
 #  if ENABLE_NLS
 #   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
-#   define YY_(msgid) dgettext ("bison-runtime", msgid)
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
 #  endif
 # endif
 # ifndef YY_
-#  define YY_(msgid) msgid
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(e) ((void) (e))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(e) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-/* Identity function, used to suppress warnings about constant conditions.  */
-#ifndef lint
-# define YYID(n) (n)
-#else
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static int
-YYID (int i)
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
 #else
-static int
-YYID (i)
-    int i;
+# define YY_INITIAL_VALUE(Value) Value
 #endif
-{
-  return i;
-}
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
 #endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#if !defined yyoverflow
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -315,11 +400,11 @@ YYID (i)
 #    define alloca _alloca
 #   else
 #    define YYSTACK_ALLOC alloca
-#    if ! defined _ALLOCA_H && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
 #     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#     ifndef _STDLIB_H
-#      define _STDLIB_H 1
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
 #     endif
 #    endif
 #   endif
@@ -327,8 +412,8 @@ YYID (i)
 # endif
 
 # ifdef YYSTACK_ALLOC
-   /* Pacify GCC's `empty if-body' warning.  */
-#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (YYID (0))
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
     /* The OS might guarantee only one guard page at the bottom of the stack,
        and a page size can be as small as 4096 bytes.  So we cannot safely
@@ -342,94 +427,96 @@ YYID (i)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
 #   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
 #  endif
-#  if (defined __cplusplus && ! defined _STDLIB_H \
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
        && ! ((defined YYMALLOC || defined malloc) \
-	     && (defined YYFREE || defined free)))
+             && (defined YYFREE || defined free)))
 #   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#   ifndef _STDLIB_H
-#    define _STDLIB_H 1
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
 #   endif
 #  endif
 #  ifndef YYMALLOC
 #   define YYMALLOC malloc
-#   if ! defined malloc && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined malloc && ! defined EXIT_SUCCESS
 void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 #  ifndef YYFREE
 #   define YYFREE free
-#   if ! defined free && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined free && ! defined EXIT_SUCCESS
 void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
-	 || (defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL \
-	     && defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+         || (defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL \
+             && defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
 
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss;
-  YYSTYPE yyvs;
-    YYLTYPE yyls;
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+  YYLTYPE yyls_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE) + sizeof (YYLTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE) \
+             + YYSIZEOF (YYLTYPE)) \
       + 2 * YYSTACK_GAP_MAXIMUM)
 
-/* Copy COUNT objects from FROM to TO.  The source and destination do
-   not overlap.  */
-# ifndef YYCOPY
-#  if defined __GNUC__ && 1 < __GNUC__
-#   define YYCOPY(To, From, Count) \
-      __builtin_memcpy (To, From, (Count) * sizeof (*(From)))
-#  else
-#   define YYCOPY(To, From, Count)		\
-      do					\
-	{					\
-	  YYSIZE_T yyi;				\
-	  for (yyi = 0; yyi < (Count); yyi++)	\
-	    (To)[yyi] = (From)[yyi];		\
-	}					\
-      while (YYID (0))
-#  endif
-# endif
+# define YYCOPY_NEEDED 1
 
 /* Relocate STACK from its old location to the new one.  The
    local variables YYSIZE and YYSTACKSIZE give the old and new number of
    elements in the stack, and YYPTR gives the new location of the
    stack.  Advance YYPTR to a properly aligned location for the next
    stack.  */
-# define YYSTACK_RELOCATE(Stack)					\
-    do									\
-      {									\
-	YYSIZE_T yynewbytes;						\
-	YYCOPY (&yyptr->Stack, Stack, yysize);				\
-	Stack = &yyptr->Stack;						\
-	yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-	yyptr += yynewbytes / sizeof (*yyptr);				\
-      }									\
-    while (YYID (0))
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
 
 #endif
 
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
 /* YYFINAL -- State number of the termination state.  */
 #define YYFINAL  3
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   184
+#define YYLAST   193
 
 /* YYNTOKENS -- Number of terminals.  */
 #define YYNTOKENS  35
@@ -437,18 +524,23 @@ union yyalloc
 #define YYNNTS  25
 /* YYNRULES -- Number of rules.  */
 #define YYNRULES  59
-/* YYNRULES -- Number of states.  */
+/* YYNSTATES -- Number of states.  */
 #define YYNSTATES  110
 
-/* YYTRANSLATE(YYLEX) -- Bison symbol number corresponding to YYLEX.  */
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   274
 
-#define YYTRANSLATE(YYX)						\
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
 
-/* YYTRANSLATE[YYLEX] -- Bison symbol number corresponding to YYLEX.  */
-static const yytype_uint8 yytranslate[] =
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -481,315 +573,261 @@ static const yytype_uint8 yytranslate[] =
 };
 
 #if YYDEBUG
-/* YYPRHS[YYN] -- Index of the first RHS symbol of rule number YYN in
-   YYRHS.  */
-static const yytype_uint8 yyprhs[] =
-{
-       0,     0,     3,     6,     7,    10,    13,    20,    21,    24,
-      25,    28,    32,    33,    37,    42,    50,    51,    54,    55,
-      58,    59,    62,    66,    70,    74,    80,    84,    87,    91,
-      92,    95,    99,   100,   103,   105,   109,   111,   113,   115,
-     119,   123,   127,   131,   135,   139,   143,   147,   151,   155,
-     159,   163,   166,   173,   178,   179,   181,   182,   185,   186
-};
-
-/* YYRHS -- A `-1'-separated list of the rules' RHS.  */
-static const yytype_int8 yyrhs[] =
-{
-      36,     0,    -1,    37,    48,    -1,    -1,    37,    38,    -1,
-      39,    44,    -1,     6,     5,    28,    41,    29,    40,    -1,
-      -1,     8,     5,    -1,    -1,    42,    43,    -1,     5,    30,
-       5,    -1,    -1,    43,    31,    42,    -1,    32,    48,    46,
-      33,    -1,     7,     5,    28,    41,    29,    47,    49,    -1,
-      -1,    46,    45,    -1,    -1,    30,     5,    -1,    -1,    48,
-      50,    -1,    32,    48,    33,    -1,    51,    52,    54,    -1,
-      12,    56,    49,    -1,    55,    47,    22,    56,    34,    -1,
-      13,    57,    34,    -1,    56,    34,    -1,     9,    56,    49,
-      -1,    -1,    52,    53,    -1,    10,    56,    49,    -1,    -1,
-      11,    49,    -1,     5,    -1,    56,    27,     5,    -1,     4,
-      -1,     3,    -1,    55,    -1,    56,    23,    56,    -1,    56,
-      24,    56,    -1,    56,    25,    56,    -1,    56,    26,    56,
-      -1,    28,    56,    29,    -1,    56,    16,    56,    -1,    56,
-      15,    56,    -1,    56,    20,    56,    -1,    56,    14,    56,
-      -1,    56,    21,    56,    -1,    56,    17,    56,    -1,    56,
-      18,    56,    -1,    19,    56,    -1,    56,    27,     5,    28,
-      58,    29,    -1,     5,    28,    58,    29,    -1,    -1,    56,
-      -1,    -1,    56,    59,    -1,    -1,    59,    31,    56,    -1
-};
-
-/* YYRLINE[YYN] -- source line where rule number YYN was defined.  */
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_uint8 yyrline[] =
 {
        0,    95,    95,    99,   100,   104,   108,   112,   113,   117,
-     118,   122,   126,   127,   131,   134,   138,   139,   143,   144,
-     148,   149,   153,   157,   158,   159,   160,   161,   165,   169,
-     170,   174,   178,   179,   183,   184,   188,   189,   190,   191,
-     192,   193,   194,   195,   196,   197,   198,   199,   200,   201,
-     202,   203,   204,   205,   209,   210,   214,   215,   219,   220
+     118,   122,   127,   128,   132,   135,   139,   140,   144,   145,
+     149,   150,   154,   158,   159,   160,   161,   162,   166,   170,
+     171,   175,   179,   180,   184,   185,   189,   190,   191,   192,
+     193,   194,   195,   196,   197,   198,   199,   200,   201,   202,
+     203,   204,   205,   206,   210,   211,   215,   216,   220,   221
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || YYTOKEN_TABLE
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "INT_LIT", "STRING_LIT", "IDENT",
-  "CLASS", "DEF", "EXTENDS", "IF", "ELIF", "ELSE", "WHILE", "RETURN",
-  "ATLEAST", "ATMOST", "EQUALS", "AND", "OR", "NOT", "'<'", "'>'", "'='",
-  "'+'", "'-'", "'*'", "'/'", "'.'", "'('", "')'", "':'", "','", "'{'",
-  "'}'", "';'", "$accept", "program", "class_star", "class",
-  "class_signature", "extends_option", "formal_args", "formal_arg",
-  "extra_formal_args_star", "class_body", "method", "method_star",
+  "\"end of file\"", "error", "\"invalid token\"", "INT_LIT",
+  "STRING_LIT", "IDENT", "CLASS", "DEF", "EXTENDS", "IF", "ELIF", "ELSE",
+  "WHILE", "RETURN", "ATLEAST", "ATMOST", "EQUALS", "AND", "OR", "NOT",
+  "'<'", "'>'", "'='", "'+'", "'-'", "'*'", "'/'", "'.'", "'('", "')'",
+  "':'", "','", "'{'", "'}'", "';'", "$accept", "program", "class_star",
+  "class", "class_signature", "extends_option", "formal_args",
+  "formal_arg", "formal_arg_list", "class_body", "method", "method_star",
   "ident_option", "statement_star", "statement_block", "statement",
   "if_clause", "elif_star", "elif_clause", "else_option", "l_expr",
-  "r_expr", "r_expr_option", "actual_args", "extra_actual_args", 0
+  "r_expr", "r_expr_option", "actual_args", "actual_arg_list", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[YYLEX-NUM] -- Internal token number corresponding to
-   token YYLEX-NUM.  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-      60,    62,    61,    43,    45,    42,    47,    46,    40,    41,
-      58,    44,   123,   125,    59
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-/* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
-{
-       0,    35,    36,    37,    37,    38,    39,    40,    40,    41,
-      41,    42,    43,    43,    44,    45,    46,    46,    47,    47,
-      48,    48,    49,    50,    50,    50,    50,    50,    51,    52,
-      52,    53,    54,    54,    55,    55,    56,    56,    56,    56,
-      56,    56,    56,    56,    56,    56,    56,    56,    56,    56,
-      56,    56,    56,    56,    57,    57,    58,    58,    59,    59
-};
+#define YYPACT_NINF (-28)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-/* YYR2[YYN] -- Number of symbols composing right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
+#define YYTABLE_NINF (-19)
+
+#define yytable_value_is_error(Yyn) \
+  0
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
 {
-       0,     2,     2,     0,     2,     2,     6,     0,     2,     0,
-       2,     3,     0,     3,     4,     7,     0,     2,     0,     2,
-       0,     2,     3,     3,     3,     5,     3,     2,     3,     0,
-       2,     3,     0,     2,     1,     3,     1,     1,     1,     3,
-       3,     3,     3,     3,     3,     3,     3,     3,     3,     3,
-       3,     2,     6,     4,     0,     1,     0,     2,     0,     3
+     -28,     1,     6,   -28,    18,   -28,   -21,    81,    -2,   -28,
+     -28,   -28,   -28,    -1,     5,     5,     5,     5,     5,   -28,
+     -28,   -17,    87,    20,    81,     5,   -28,   117,   117,   152,
+       0,   166,   136,    -4,    23,     9,     5,     5,     5,     5,
+       5,     5,     5,     5,     5,     5,     5,    27,   -28,     8,
+       7,   -28,    26,    -3,   152,    10,    30,   -28,   -28,   -28,
+     -28,   -28,     5,     3,   -28,   -28,   -28,     5,    29,    29,
+      29,   166,   166,    29,    29,   -11,   -11,    35,    35,    37,
+      64,    62,    20,    67,   -28,   -28,   -28,     5,    55,   117,
+     -28,   102,     5,   -28,    68,   -28,   -28,    47,   152,   -28,
+     -28,   -28,    48,   -28,    20,   -28,    49,    46,     3,   -28
 };
 
-/* YYDEFACT[STATE-NAME] -- Default rule to reduce with in state
-   STATE-NUM when YYTABLE doesn't specify something else to do.  Zero
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
    means the default is an error.  */
-static const yytype_uint8 yydefact[] =
+static const yytype_int8 yydefact[] =
 {
        3,     0,    20,     1,     0,     4,     0,     2,     0,    20,
        5,    37,    36,    34,     0,     0,    54,     0,     0,    21,
       29,    38,     0,     9,    16,    56,    38,     0,     0,    55,
        0,    51,     0,    32,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,    27,     0,
-       0,    12,     0,    58,     0,    20,    28,    24,    26,    43,
-       0,     0,    30,    23,    19,     0,    47,    45,    44,    49,
-      50,    46,    48,    39,    40,    41,    42,    35,     0,     7,
-      10,     0,    14,    17,    57,    53,     0,     0,    33,     0,
-      56,    11,     0,     6,     0,     0,     0,    22,    31,    25,
-       0,     8,    13,     9,    59,    52,     0,    18,     0,    15
+       0,    12,    10,     0,    58,     0,    57,    20,    28,    24,
+      26,    43,     0,     0,    30,    23,    19,     0,    47,    45,
+      44,    49,    50,    46,    48,    39,    40,    41,    42,    35,
+       0,     7,     0,     0,    14,    17,    53,     0,     0,     0,
+      33,     0,    56,    11,     0,     6,    13,     0,    59,    22,
+      31,    25,     0,     8,     9,    52,     0,    18,     0,    15
 };
 
-/* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int8 yydefgoto[] =
-{
-      -1,     1,     2,     5,     6,    93,    50,    51,    80,    10,
-      83,    52,    35,     7,    56,    19,    20,    33,    62,    63,
-      26,    22,    30,    54,    84
-};
-
-/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-   STATE-NUM.  */
-#define YYPACT_NINF -24
-static const yytype_int16 yypact[] =
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int8 yypgoto[] =
 {
-     -24,    17,    12,   -24,    31,   -24,     5,    56,    11,   -24,
-     -24,   -24,   -24,    13,    16,    16,    16,    16,    16,   -24,
-     -24,   -15,    73,    35,    56,    16,   -24,   103,   103,   138,
-       8,   152,   122,    -1,    38,    23,    16,    16,    16,    16,
-      16,    16,    16,    16,    16,    16,    16,    45,   -24,    24,
-      26,   -24,     1,   138,    29,   -24,   -24,   -24,   -24,   -24,
-      16,    30,   -24,   -24,   -24,    16,   157,   157,   157,   152,
-     152,   157,   157,   -13,   -13,    39,    39,    42,    62,    63,
-      43,    68,   -24,   -24,    47,   -24,    44,   103,   -24,    88,
-      16,   -24,    74,   -24,    35,    52,    16,   -24,   -24,   -24,
-      54,   -24,   -24,    35,   138,   -24,    57,    51,    30,   -24
+     -28,   -28,   -28,   -28,   -28,   -28,   -25,    13,   -28,   -28,
+     -28,   -28,   -27,    -6,   -26,   -28,   -28,   -28,   -28,   -28,
+      -7,     4,   -28,    -5,   -28
 };
 
-/* YYPGOTO[NTERM-NUM].  */
-static const yytype_int8 yypgoto[] =
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_int8 yydefgoto[] =
 {
-     -24,   -24,   -24,   -24,   -24,   -24,   -11,     7,   -24,   -24,
-     -24,   -24,     3,    -3,   -23,   -24,   -24,   -24,   -24,   -24,
-       9,   -14,   -24,    41,   -24
+       0,     1,     2,     5,     6,    95,    50,    51,    52,    10,
+      85,    53,    35,     7,    58,    19,    20,    33,    64,    65,
+      26,    22,    30,    55,    56
 };
 
-/* YYTABLE[YYPACT[STATE-NUM]].  What to do in state STATE-NUM.  If
-   positive, shift that token.  If negative, reduce the rule which
-   number is the opposite.  If zero, do what YYDEFACT says.
-   If YYTABLE_NINF, syntax error.  */
-#define YYTABLE_NINF -19
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int8 yytable[] =
 {
-      27,    28,    29,    31,    32,    57,    24,   -18,    81,    60,
-      61,    53,    45,    46,    47,    34,    21,     3,     4,    11,
-      12,    13,    66,    67,    68,    69,    70,    71,    72,    73,
-      74,    75,    76,    21,    82,    17,     8,     9,    88,    23,
-      49,    25,    58,    64,    18,    65,    87,    11,    12,    13,
-      77,    89,    86,    14,    78,    79,    15,    16,    85,    11,
-      12,    13,    55,    17,    98,    14,    47,    91,    15,    16,
-      90,    92,    18,    95,    94,    17,    53,    97,    96,   101,
-     103,    34,   104,   105,    18,   109,   107,    36,    37,    38,
-      39,    40,   106,    41,    42,    21,    43,    44,    45,    46,
-      47,   102,    36,    37,    38,    39,    40,    48,    41,    42,
-     108,    43,    44,    45,    46,    47,     0,    36,    37,    38,
-      39,    40,    99,    41,    42,     0,    43,    44,    45,    46,
-      47,   100,     0,     0,     0,    55,    36,    37,    38,    39,
+      21,     3,    59,    24,    83,   -18,    62,    63,    11,    12,
+      13,     9,     4,    34,    45,    46,    47,    21,    27,    28,
+      29,    31,    32,     8,    17,    49,    23,    25,    66,    54,
+      84,    67,    79,    18,    60,    57,    81,    90,    80,    86,
+      68,    69,    70,    71,    72,    73,    74,    75,    76,    77,
+      78,    88,    43,    44,    45,    46,    47,    82,    11,    12,
+      13,    87,    47,   100,    14,    92,    89,    15,    16,    93,
+      94,    91,    97,   103,    17,   104,    34,   105,   107,   106,
+     108,    21,   109,    18,    11,    12,    13,   102,    99,     0,
+      14,    98,     0,    15,    16,    96,    54,     0,     0,     0,
+      17,    36,    37,    38,    39,    40,     0,    41,    42,    18,
+      43,    44,    45,    46,    47,     0,    36,    37,    38,    39,
+      40,    48,    41,    42,     0,    43,    44,    45,    46,    47,
+       0,    36,    37,    38,    39,    40,   101,    41,    42,     0,
+      43,    44,    45,    46,    47,     0,     0,     0,     0,    57,
+      36,    37,    38,    39,    40,     0,    41,    42,     0,    43,
+      44,    45,    46,    47,     0,    61,    36,    37,    38,    39,
       40,     0,    41,    42,     0,    43,    44,    45,    46,    47,
-       0,    59,    36,    37,    38,    39,    40,     0,    41,    42,
-       0,    43,    44,    45,    46,    47,    36,    37,    38,     0,
-       0,     0,    41,    42,     0,    43,    44,    45,    46,    47,
-      43,    44,    45,    46,    47
+      36,    37,    38,     0,     0,     0,    41,    42,     0,    43,
+      44,    45,    46,    47
 };
 
 static const yytype_int8 yycheck[] =
 {
-      14,    15,    16,    17,    18,    28,     9,    22,     7,    10,
-      11,    25,    25,    26,    27,    30,     7,     0,     6,     3,
-       4,     5,    36,    37,    38,    39,    40,    41,    42,    43,
-      44,    45,    46,    24,    33,    19,     5,    32,    61,    28,
-       5,    28,    34,     5,    28,    22,    60,     3,     4,     5,
-       5,    65,    55,     9,    30,    29,    12,    13,    29,     3,
-       4,     5,    32,    19,    87,     9,    27,     5,    12,    13,
-      28,     8,    28,     5,    31,    19,    90,    33,    31,     5,
-      28,    30,    96,    29,    28,   108,    29,    14,    15,    16,
-      17,    18,   103,    20,    21,    86,    23,    24,    25,    26,
-      27,    94,    14,    15,    16,    17,    18,    34,    20,    21,
-     107,    23,    24,    25,    26,    27,    -1,    14,    15,    16,
-      17,    18,    34,    20,    21,    -1,    23,    24,    25,    26,
-      27,    90,    -1,    -1,    -1,    32,    14,    15,    16,    17,
+       7,     0,    28,     9,     7,    22,    10,    11,     3,     4,
+       5,    32,     6,    30,    25,    26,    27,    24,    14,    15,
+      16,    17,    18,     5,    19,     5,    28,    28,     5,    25,
+      33,    22,     5,    28,    34,    32,    29,    63,    30,    29,
+      36,    37,    38,    39,    40,    41,    42,    43,    44,    45,
+      46,    57,    23,    24,    25,    26,    27,    31,     3,     4,
+       5,    31,    27,    89,     9,    28,    62,    12,    13,     5,
+       8,    67,     5,     5,    19,    28,    30,    29,    29,   104,
+     107,    88,   108,    28,     3,     4,     5,    92,    33,    -1,
+       9,    87,    -1,    12,    13,    82,    92,    -1,    -1,    -1,
+      19,    14,    15,    16,    17,    18,    -1,    20,    21,    28,
+      23,    24,    25,    26,    27,    -1,    14,    15,    16,    17,
+      18,    34,    20,    21,    -1,    23,    24,    25,    26,    27,
+      -1,    14,    15,    16,    17,    18,    34,    20,    21,    -1,
+      23,    24,    25,    26,    27,    -1,    -1,    -1,    -1,    32,
+      14,    15,    16,    17,    18,    -1,    20,    21,    -1,    23,
+      24,    25,    26,    27,    -1,    29,    14,    15,    16,    17,
       18,    -1,    20,    21,    -1,    23,    24,    25,    26,    27,
-      -1,    29,    14,    15,    16,    17,    18,    -1,    20,    21,
-      -1,    23,    24,    25,    26,    27,    14,    15,    16,    -1,
-      -1,    -1,    20,    21,    -1,    23,    24,    25,    26,    27,
-      23,    24,    25,    26,    27
+      14,    15,    16,    -1,    -1,    -1,    20,    21,    -1,    23,
+      24,    25,    26,    27
 };
 
-/* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-   symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
        0,    36,    37,     0,     6,    38,    39,    48,     5,    32,
       44,     3,     4,     5,     9,    12,    13,    19,    28,    50,
       51,    55,    56,    28,    48,    28,    55,    56,    56,    56,
       57,    56,    56,    52,    30,    47,    14,    15,    16,    17,
       18,    20,    21,    23,    24,    25,    26,    27,    34,     5,
-      41,    42,    46,    56,    58,    32,    49,    49,    34,    29,
-      10,    11,    53,    54,     5,    22,    56,    56,    56,    56,
-      56,    56,    56,    56,    56,    56,    56,     5,    30,    29,
-      43,     7,    33,    45,    59,    29,    48,    56,    49,    56,
-      28,     5,     8,    40,    31,     5,    31,    33,    49,    34,
-      58,     5,    42,    28,    56,    29,    41,    29,    47,    49
+      41,    42,    43,    46,    56,    58,    59,    32,    49,    49,
+      34,    29,    10,    11,    53,    54,     5,    22,    56,    56,
+      56,    56,    56,    56,    56,    56,    56,    56,    56,     5,
+      30,    29,    31,     7,    33,    45,    29,    31,    48,    56,
+      49,    56,    28,     5,     8,    40,    42,     5,    56,    33,
+      49,    34,    58,     5,    28,    29,    41,    29,    47,    49
 };
 
-#define yyerrok		(yyerrstatus = 0)
-#define yyclearin	(yychar = YYEMPTY)
-#define YYEMPTY		(-2)
-#define YYEOF		0
-
-#define YYACCEPT	goto yyacceptlab
-#define YYABORT		goto yyabortlab
-#define YYERROR		goto yyerrorlab
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
+{
+       0,    35,    36,    37,    37,    38,    39,    40,    40,    41,
+      41,    42,    43,    43,    44,    45,    46,    46,    47,    47,
+      48,    48,    49,    50,    50,    50,    50,    50,    51,    52,
+      52,    53,    54,    54,    55,    55,    56,    56,    56,    56,
+      56,    56,    56,    56,    56,    56,    56,    56,    56,    56,
+      56,    56,    56,    56,    57,    57,    58,    58,    59,    59
+};
 
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     2,     0,     2,     2,     6,     0,     2,     0,
+       1,     3,     1,     3,     4,     7,     0,     2,     0,     2,
+       0,     2,     3,     3,     3,     5,     3,     2,     3,     0,
+       2,     3,     0,     2,     1,     3,     1,     1,     1,     3,
+       3,     3,     3,     3,     3,     3,     3,     3,     3,     3,
+       3,     2,     6,     4,     0,     1,     0,     1,     1,     3
+};
 
-/* Like YYERROR except do call yyerror.  This remains here temporarily
-   to ease the transition to the new meaning of YYERROR, for GCC.
-   Once GCC version 2 has supplanted version 1, this can go.  */
 
-#define YYFAIL		goto yyerrlab
+enum { YYENOMEM = -2 };
 
-#define YYRECOVERING()  (!!yyerrstatus)
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
 
-#define YYBACKUP(Token, Value)					\
-do								\
-  if (yychar == YYEMPTY && yylen == 1)				\
-    {								\
-      yychar = (Token);						\
-      yylval = (Value);						\
-      yytoken = YYTRANSLATE (yychar);				\
-      YYPOPSTACK (1);						\
-      goto yybackup;						\
-    }								\
-  else								\
-    {								\
-      yyerror (YY_("syntax error: cannot back up")); \
-      YYERROR;							\
-    }								\
-while (YYID (0))
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
-#define YYTERROR	1
-#define YYERRCODE	256
+#define YYRECOVERING()  (!!yyerrstatus)
 
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 /* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
    If N is 0, then set CURRENT to the empty location which ends
    the previous symbol: RHS[0] (always defined).  */
 
-#define YYRHSLOC(Rhs, K) ((Rhs)[K])
 #ifndef YYLLOC_DEFAULT
-# define YYLLOC_DEFAULT(Current, Rhs, N)				\
-    do									\
-      if (YYID (N))                                                    \
-	{								\
-	  (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;	\
-	  (Current).first_column = YYRHSLOC (Rhs, 1).first_column;	\
-	  (Current).last_line    = YYRHSLOC (Rhs, N).last_line;		\
-	  (Current).last_column  = YYRHSLOC (Rhs, N).last_column;	\
-	}								\
-      else								\
-	{								\
-	  (Current).first_line   = (Current).last_line   =		\
-	    YYRHSLOC (Rhs, 0).last_line;				\
-	  (Current).first_column = (Current).last_column =		\
-	    YYRHSLOC (Rhs, 0).last_column;				\
-	}								\
-    while (YYID (0))
-#endif
-
-
-/* YY_LOCATION_PRINT -- Print the location on the stream.
-   This macro was not mandated originally: define only if we know
-   we won't break user code: when these are the locations we know.  */
-
-#ifndef YY_LOCATION_PRINT
-# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
-#  define YY_LOCATION_PRINT(File, Loc)			\
-     fprintf (File, "%d.%d-%d.%d",			\
-	      (Loc).first_line, (Loc).first_column,	\
-	      (Loc).last_line,  (Loc).last_column)
-# else
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
+# define YYLLOC_DEFAULT(Current, Rhs, N)                                \
+    do                                                                  \
+      if (N)                                                            \
+        {                                                               \
+          (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;        \
+          (Current).first_column = YYRHSLOC (Rhs, 1).first_column;      \
+          (Current).last_line    = YYRHSLOC (Rhs, N).last_line;         \
+          (Current).last_column  = YYRHSLOC (Rhs, N).last_column;       \
+        }                                                               \
+      else                                                              \
+        {                                                               \
+          (Current).first_line   = (Current).last_line   =              \
+            YYRHSLOC (Rhs, 0).last_line;                                \
+          (Current).first_column = (Current).last_column =              \
+            YYRHSLOC (Rhs, 0).last_column;                              \
+        }                                                               \
+    while (0)
 #endif
 
+#define YYRHSLOC(Rhs, K) ((Rhs)[K])
 
-/* YYLEX -- calling `yylex' with the right arguments.  */
-
-#ifdef YYLEX_PARAM
-# define YYLEX yylex (YYLEX_PARAM)
-#else
-# define YYLEX yylex ()
-#endif
 
 /* Enable debugging if requested.  */
 #if YYDEBUG
@@ -799,85 +837,118 @@ while (YYID (0))
 #  define YYFPRINTF fprintf
 # endif
 
-# define YYDPRINTF(Args)			\
-do {						\
-  if (yydebug)					\
-    YYFPRINTF Args;				\
-} while (YYID (0))
-
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)			  \
-do {									  \
-  if (yydebug)								  \
-    {									  \
-      YYFPRINTF (stderr, "%s ", Title);					  \
-      yy_symbol_print (stderr,						  \
-		  Type, Value, Location); \
-      YYFPRINTF (stderr, "\n");						  \
-    }									  \
-} while (YYID (0))
-
-
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
-
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
-#else
-static void
-yy_symbol_value_print (yyoutput, yytype, yyvaluep, yylocationp)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-    YYLTYPE const * const yylocationp;
-#endif
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+/* YYLOCATION_PRINT -- Print the location on the stream.
+   This macro was not mandated originally: define only if we know
+   we won't break user code: when these are the locations we know.  */
+
+# ifndef YYLOCATION_PRINT
+
+#  if defined YY_LOCATION_PRINT
+
+   /* Temporary convenience wrapper in case some people defined the
+      undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YYLOCATION_PRINT(File, Loc)  YY_LOCATION_PRINT(File, *(Loc))
+
+#  elif defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+
+/* Print *YYLOCP on YYO.  Private, do not rely on its existence. */
+
+YY_ATTRIBUTE_UNUSED
+static int
+yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
 {
-  if (!yyvaluep)
-    return;
-  YYUSE (yylocationp);
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# else
-  YYUSE (yyoutput);
-# endif
-  switch (yytype)
+  int res = 0;
+  int end_col = 0 != yylocp->last_column ? yylocp->last_column - 1 : 0;
+  if (0 <= yylocp->first_line)
+    {
+      res += YYFPRINTF (yyo, "%d", yylocp->first_line);
+      if (0 <= yylocp->first_column)
+        res += YYFPRINTF (yyo, ".%d", yylocp->first_column);
+    }
+  if (0 <= yylocp->last_line)
     {
-      default:
-	break;
+      if (yylocp->first_line < yylocp->last_line)
+        {
+          res += YYFPRINTF (yyo, "-%d", yylocp->last_line);
+          if (0 <= end_col)
+            res += YYFPRINTF (yyo, ".%d", end_col);
+        }
+      else if (0 <= end_col && yylocp->first_column < end_col)
+        res += YYFPRINTF (yyo, "-%d", end_col);
     }
+  return res;
 }
 
+#   define YYLOCATION_PRINT  yy_location_print_
+
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT(File, Loc)  YYLOCATION_PRINT(File, &(Loc))
+
+#  else
+
+#   define YYLOCATION_PRINT(File, Loc) ((void) 0)
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT  YYLOCATION_PRINT
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+#  endif
+# endif /* !defined YYLOCATION_PRINT */
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value, Location); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
-#else
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
+{
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (yylocationp);
+  if (!yyvaluep)
+    return;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
+
 static void
-yy_symbol_print (yyoutput, yytype, yyvaluep, yylocationp)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-    YYLTYPE const * const yylocationp;
-#endif
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
 {
-  if (yytype < YYNTOKENS)
-    YYFPRINTF (yyoutput, "token %s (", yytname[yytype]);
-  else
-    YYFPRINTF (yyoutput, "nterm %s (", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  YY_LOCATION_PRINT (yyoutput, *yylocationp);
-  YYFPRINTF (yyoutput, ": ");
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep, yylocationp);
-  YYFPRINTF (yyoutput, ")");
+  YYLOCATION_PRINT (yyo, yylocationp);
+  YYFPRINTF (yyo, ": ");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, yylocationp);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -885,81 +956,69 @@ yy_symbol_print (yyoutput, yytype, yyvaluep, yylocationp)
 | TOP (included).                                                   |
 `------------------------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_stack_print (yytype_int16 *bottom, yytype_int16 *top)
-#else
-static void
-yy_stack_print (bottom, top)
-    yytype_int16 *bottom;
-    yytype_int16 *top;
-#endif
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
-  for (; bottom <= top; ++bottom)
-    YYFPRINTF (stderr, " %d", *bottom);
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
   YYFPRINTF (stderr, "\n");
 }
 
-# define YY_STACK_PRINT(Bottom, Top)				\
-do {								\
-  if (yydebug)							\
-    yy_stack_print ((Bottom), (Top));				\
-} while (YYID (0))
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
 
 
 /*------------------------------------------------.
 | Report that the YYRULE is going to be reduced.  |
 `------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_reduce_print (YYSTYPE *yyvsp, YYLTYPE *yylsp, int yyrule)
-#else
-static void
-yy_reduce_print (yyvsp, yylsp, yyrule)
-    YYSTYPE *yyvsp;
-    YYLTYPE *yylsp;
-    int yyrule;
-#endif
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp,
+                 int yyrule)
 {
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  unsigned long int yylno = yyrline[yyrule];
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
-	     yyrule - 1, yylno);
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
-      fprintf (stderr, "   $%d = ", yyi + 1);
-      yy_symbol_print (stderr, yyrhs[yyprhs[yyrule] + yyi],
-		       &(yyvsp[(yyi + 1) - (yynrhs)])
-		       , &(yylsp[(yyi + 1) - (yynrhs)])		       );
-      fprintf (stderr, "\n");
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)],
+                       &(yylsp[(yyi + 1) - (yynrhs)]));
+      YYFPRINTF (stderr, "\n");
     }
 }
 
-# define YY_REDUCE_PRINT(Rule)		\
-do {					\
-  if (yydebug)				\
-    yy_reduce_print (yyvsp, yylsp, Rule); \
-} while (YYID (0))
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, yylsp, Rule); \
+} while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
 
 
 /* YYINITDEPTH -- initial size of the parser's stacks.  */
-#ifndef	YYINITDEPTH
+#ifndef YYINITDEPTH
 # define YYINITDEPTH 200
 #endif
 
@@ -974,281 +1033,45 @@ int yydebug;
 # define YYMAXDEPTH 10000
 #endif
 
-
 
-#if YYERROR_VERBOSE
 
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
-/* Return the length of YYSTR.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static YYSIZE_T
-yystrlen (const char *yystr)
-#else
-static YYSIZE_T
-yystrlen (yystr)
-    const char *yystr;
-#endif
-{
-  YYSIZE_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
-
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-#else
-static char *
-yystpcpy (yydest, yysrc)
-    char *yydest;
-    const char *yysrc;
-#endif
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
-
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
-
-  return yyd - 1;
-}
-#  endif
-# endif
-
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYSIZE_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-	switch (*++yyp)
-	  {
-	  case '\'':
-	  case ',':
-	    goto do_not_strip_quotes;
-
-	  case '\\':
-	    if (*++yyp != '\\')
-	      goto do_not_strip_quotes;
-	    /* Fall through.  */
-	  default:
-	    if (yyres)
-	      yyres[yyn] = *yyp;
-	    yyn++;
-	    break;
-
-	  case '"':
-	    if (yyres)
-	      yyres[yyn] = '\0';
-	    return yyn;
-	  }
-    do_not_strip_quotes: ;
-    }
-
-  if (! yyres)
-    return yystrlen (yystr);
-
-  return yystpcpy (yyres, yystr) - yyres;
-}
-# endif
 
-/* Copy into YYRESULT an error message about the unexpected token
-   YYCHAR while in state YYSTATE.  Return the number of bytes copied,
-   including the terminating null byte.  If YYRESULT is null, do not
-   copy anything; just return the number of bytes that would be
-   copied.  As a special case, return 0 if an ordinary "syntax error"
-   message will do.  Return YYSIZE_MAXIMUM if overflow occurs during
-   size calculation.  */
-static YYSIZE_T
-yysyntax_error (char *yyresult, int yystate, int yychar)
-{
-  int yyn = yypact[yystate];
 
-  if (! (YYPACT_NINF < yyn && yyn <= YYLAST))
-    return 0;
-  else
-    {
-      int yytype = YYTRANSLATE (yychar);
-      YYSIZE_T yysize0 = yytnamerr (0, yytname[yytype]);
-      YYSIZE_T yysize = yysize0;
-      YYSIZE_T yysize1;
-      int yysize_overflow = 0;
-      enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-      char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-      int yyx;
-
-# if 0
-      /* This is so xgettext sees the translatable formats that are
-	 constructed on the fly.  */
-      YY_("syntax error, unexpected %s");
-      YY_("syntax error, unexpected %s, expecting %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s or %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s");
-# endif
-      char *yyfmt;
-      char const *yyf;
-      static char const yyunexpected[] = "syntax error, unexpected %s";
-      static char const yyexpecting[] = ", expecting %s";
-      static char const yyor[] = " or %s";
-      char yyformat[sizeof yyunexpected
-		    + sizeof yyexpecting - 1
-		    + ((YYERROR_VERBOSE_ARGS_MAXIMUM - 2)
-		       * (sizeof yyor - 1))];
-      char const *yyprefix = yyexpecting;
-
-      /* Start YYX at -YYN if negative to avoid negative indexes in
-	 YYCHECK.  */
-      int yyxbegin = yyn < 0 ? -yyn : 0;
-
-      /* Stay within bounds of both yycheck and yytname.  */
-      int yychecklim = YYLAST - yyn + 1;
-      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-      int yycount = 1;
-
-      yyarg[0] = yytname[yytype];
-      yyfmt = yystpcpy (yyformat, yyunexpected);
-
-      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-	if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR)
-	  {
-	    if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-	      {
-		yycount = 1;
-		yysize = yysize0;
-		yyformat[sizeof yyunexpected - 1] = '\0';
-		break;
-	      }
-	    yyarg[yycount++] = yytname[yyx];
-	    yysize1 = yysize + yytnamerr (0, yytname[yyx]);
-	    yysize_overflow |= (yysize1 < yysize);
-	    yysize = yysize1;
-	    yyfmt = yystpcpy (yyfmt, yyprefix);
-	    yyprefix = yyor;
-	  }
-
-      yyf = YY_(yyformat);
-      yysize1 = yysize + yystrlen (yyf);
-      yysize_overflow |= (yysize1 < yysize);
-      yysize = yysize1;
-
-      if (yysize_overflow)
-	return YYSIZE_MAXIMUM;
-
-      if (yyresult)
-	{
-	  /* Avoid sprintf, as that infringes on the user's name space.
-	     Don't have undefined behavior even if the translation
-	     produced a string with the wrong number of "%s"s.  */
-	  char *yyp = yyresult;
-	  int yyi = 0;
-	  while ((*yyp = *yyf) != '\0')
-	    {
-	      if (*yyp == '%' && yyf[1] == 's' && yyi < yycount)
-		{
-		  yyp += yytnamerr (yyp, yyarg[yyi++]);
-		  yyf += 2;
-		}
-	      else
-		{
-		  yyp++;
-		  yyf++;
-		}
-	    }
-	}
-      return yysize;
-    }
-}
-#endif /* YYERROR_VERBOSE */
-
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, YYLTYPE *yylocationp)
-#else
-static void
-yydestruct (yymsg, yytype, yyvaluep, yylocationp)
-    const char *yymsg;
-    int yytype;
-    YYSTYPE *yyvaluep;
-    YYLTYPE *yylocationp;
-#endif
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, YYLTYPE *yylocationp)
 {
-  YYUSE (yyvaluep);
-  YYUSE (yylocationp);
-
+  YY_USE (yyvaluep);
+  YY_USE (yylocationp);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
-
-  switch (yytype)
-    {
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
-      default:
-	break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
-
-
-/* Prevent warnings from -Wmissing-prototypes.  */
-
-#ifdef YYPARSE_PARAM
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void *YYPARSE_PARAM);
-#else
-int yyparse ();
-#endif
-#else /* ! YYPARSE_PARAM */
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void);
-#else
-int yyparse ();
-#endif
-#endif /* ! YYPARSE_PARAM */
 
 
-
-/* The look-ahead symbol.  */
+/* Lookahead token kind.  */
 int yychar;
 
-/* The semantic value of the look-ahead symbol.  */
+/* The semantic value of the lookahead symbol.  */
 YYSTYPE yylval;
-
+/* Location data for the lookahead symbol.  */
+YYLTYPE yylloc
+# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+  = { 1, 1, 1, 1 }
+# endif
+;
 /* Number of syntax errors so far.  */
 int yynerrs;
-/* Location data for the look-ahead symbol.  */
-YYLTYPE yylloc;
+
 
 
 
@@ -1256,211 +1079,196 @@ YYLTYPE yylloc;
 | yyparse.  |
 `----------*/
 
-#ifdef YYPARSE_PARAM
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-int
-yyparse (void *YYPARSE_PARAM)
-#else
-int
-yyparse (YYPARSE_PARAM)
-    void *YYPARSE_PARAM;
-#endif
-#else /* ! YYPARSE_PARAM */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 int
 yyparse (void)
-#else
-int
-yyparse ()
-
-#endif
-#endif
 {
-  
-  int yystate;
-  int yyn;
-  int yyresult;
-  /* Number of tokens to shift before error messages enabled.  */
-  int yyerrstatus;
-  /* Look-ahead token as an internal (translated) token number.  */
-  int yytoken = 0;
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
-
-  /* Three stacks and their tools:
-     `yyss': related to states,
-     `yyvs': related to semantic values,
-     `yyls': related to locations.
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
 
-     Refer to the stacks thru separate pointers, to allow yyoverflow
-     to reallocate them elsewhere.  */
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
 
-  /* The state stack.  */
-  yytype_int16 yyssa[YYINITDEPTH];
-  yytype_int16 *yyss = yyssa;
-  yytype_int16 *yyssp;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
 
-  /* The semantic value stack.  */
-  YYSTYPE yyvsa[YYINITDEPTH];
-  YYSTYPE *yyvs = yyvsa;
-  YYSTYPE *yyvsp;
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-  /* The location stack.  */
-  YYLTYPE yylsa[YYINITDEPTH];
-  YYLTYPE *yyls = yylsa;
-  YYLTYPE *yylsp;
-  /* The locations where the error started and ended.  */
-  YYLTYPE yyerror_range[2];
-
-#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N), yylsp -= (N))
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
-  YYSIZE_T yystacksize = YYINITDEPTH;
+    /* The location stack: array, bottom, top.  */
+    YYLTYPE yylsa[YYINITDEPTH];
+    YYLTYPE *yyls = yylsa;
+    YYLTYPE *yylsp = yyls;
 
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
   YYLTYPE yyloc;
 
+  /* The locations where the error started and ended.  */
+  YYLTYPE yyerror_range[3];
+
+
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N), yylsp -= (N))
+
   /* The number of symbols on the RHS of the reduced rule.
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
-  yychar = YYEMPTY;		/* Cause a token to be read.  */
-
-  /* Initialize stack pointers.
-     Waste one element of value and location stack
-     so that they stay on the same level as the state stack.
-     The wasted elements are never initialized.  */
-
-  yyssp = yyss;
-  yyvsp = yyvs;
-  yylsp = yyls;
-#if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
-  /* Initialize the default location before parsing starts.  */
-  yylloc.first_line   = yylloc.last_line   = 1;
-  yylloc.first_column = yylloc.last_column = 0;
-#endif
+  yychar = YYEMPTY; /* Cause a token to be read.  */
 
+  yylsp[0] = yylloc;
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
-	/* Give user a chance to reallocate the stack.  Use copies of
-	   these so that the &'s don't force the real ones into
-	   memory.  */
-	YYSTYPE *yyvs1 = yyvs;
-	yytype_int16 *yyss1 = yyss;
-	YYLTYPE *yyls1 = yyls;
-
-	/* Each stack pointer address is followed by the size of the
-	   data in use in that stack, in bytes.  This used to be a
-	   conditional around just the two extra args, but that might
-	   be undefined if yyoverflow is a macro.  */
-	yyoverflow (YY_("memory exhausted"),
-		    &yyss1, yysize * sizeof (*yyssp),
-		    &yyvs1, yysize * sizeof (*yyvsp),
-		    &yyls1, yysize * sizeof (*yylsp),
-		    &yystacksize);
-	yyls = yyls1;
-	yyss = yyss1;
-	yyvs = yyvs1;
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+        YYLTYPE *yyls1 = yyls;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yyls1, yysize * YYSIZEOF (*yylsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+        yyls = yyls1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-	goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
-	yystacksize = YYMAXDEPTH;
+        yystacksize = YYMAXDEPTH;
 
       {
-	yytype_int16 *yyss1 = yyss;
-	union yyalloc *yyptr =
-	  (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
-	if (! yyptr)
-	  goto yyexhaustedlab;
-	YYSTACK_RELOCATE (yyss);
-	YYSTACK_RELOCATE (yyvs);
-	YYSTACK_RELOCATE (yyls);
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+        YYSTACK_RELOCATE (yyls_alloc, yyls);
 #  undef YYSTACK_RELOCATE
-	if (yyss1 != yyssa)
-	  YYSTACK_FREE (yyss1);
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
       yylsp = yyls + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-		  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
-	YYABORT;
+        YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
-     look-ahead token if we need one and don't already have one.  */
+     lookahead token if we need one and don't already have one.  */
 
-  /* First try to decide what to do without reference to look-ahead token.  */
+  /* First try to decide what to do without reference to lookahead token.  */
   yyn = yypact[yystate];
-  if (yyn == YYPACT_NINF)
+  if (yypact_value_is_default (yyn))
     goto yydefault;
 
-  /* Not known => get a look-ahead token if don't already have one.  */
+  /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid look-ahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = YYLEX;
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex ();
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      yyerror_range[1] = yylloc;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1475,30 +1283,27 @@ yybackup:
   yyn = yytable[yyn];
   if (yyn <= 0)
     {
-      if (yyn == 0 || yyn == YYTABLE_NINF)
-	goto yyerrlab;
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
       yyn = -yyn;
       goto yyreduce;
     }
 
-  if (yyn == YYFINAL)
-    YYACCEPT;
-
   /* Count tokens shifted since error; after three, turn off error
      status.  */
   if (yyerrstatus)
     yyerrstatus--;
 
-  /* Shift the look-ahead token.  */
+  /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token unless it is eof.  */
-  if (yychar != YYEOF)
-    yychar = YYEMPTY;
-
   yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
   *++yylsp = yylloc;
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1513,14 +1318,14 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
   yylen = yyr2[yyn];
 
   /* If YYLEN is nonzero, implement the default value of the action:
-     `$$ = $1'.
+     '$$ = $1'.
 
      Otherwise, the following line sets YYVAL to garbage.
      This behavior is undocumented and Bison
@@ -1529,397 +1334,433 @@ yyreduce:
      GCC warning that YYVAL may be used uninitialized.  */
   yyval = yyvsp[1-yylen];
 
-  /* Default location.  */
+  /* Default location. */
   YYLLOC_DEFAULT (yyloc, (yylsp - yylen), yylen);
+  yyerror_range[1] = yyloc;
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 2:
+  case 2: /* program: class_star statement_star  */
 #line 95 "grammar.y"
-    {(yyval.pgm) = new Program((yyvsp[(1) - (2)].clsss), (yyvsp[(2) - (2)].stmts), (yyloc).first_line); (yyval.pgm)->setLineno((yyloc).first_line); root = (yyval.pgm);;}
+                                  {(yyval.pgm) = new Program((yyvsp[-1].clsss), (yyvsp[0].stmts), (yyloc).first_line); (yyval.pgm)->setLineno((yyloc).first_line); root = (yyval.pgm);}
+#line 1347 "grammar.tab.c"
     break;
 
-  case 3:
+  case 3: /* class_star: %empty  */
 #line 99 "grammar.y"
-    {(yyval.clsss) = new std::list<Class *>();;}
+                             {(yyval.clsss) = new NodeList<Class *>();}
+#line 1353 "grammar.tab.c"
     break;
 
-  case 4:
+  case 4: /* class_star: class_star class  */
 #line 100 "grammar.y"
-    {(yyval.clsss) = (yyvsp[(1) - (2)].clsss); (yyvsp[(1) - (2)].clsss)->push_back((yyvsp[(2) - (2)].cls));;}
+                             {(yyval.clsss) = (yyvsp[-1].clsss); (yyvsp[-1].clsss)->push_back((yyvsp[0].cls));}
+#line 1359 "grammar.tab.c"
     break;
 
-  case 5:
+  case 5: /* class: class_signature class_body  */
 #line 104 "grammar.y"
-    {(yyval.cls) = new Class((yyvsp[(1) - (2)].clssig), (yyvsp[(2) - (2)].clsbdy)); (yyval.cls)->setLineno((yyloc).first_line);;}
+                                {(yyval.cls) = new Class((yyvsp[-1].clssig), (yyvsp[0].clsbdy)); (yyval.cls)->setLineno((yyloc).first_line);}
+#line 1365 "grammar.tab.c"
     break;
 
-  case 6:
+  case 6: /* class_signature: CLASS IDENT '(' formal_args ')' extends_option  */
 #line 108 "grammar.y"
-    {(yyval.clssig) = new ClassSignature((yyvsp[(2) - (6)].id), (yyvsp[(4) - (6)].fargs), (yyvsp[(6) - (6)].exop)); (yyval.clssig)->setLineno((yyloc).first_line);;}
+                                                               {(yyval.clssig) = new ClassSignature((yyvsp[-4].id), (yyvsp[-2].fargs), (yyvsp[0].exop)); (yyval.clssig)->setLineno((yyloc).first_line);}
+#line 1371 "grammar.tab.c"
     break;
 
-  case 7:
+  case 7: /* extends_option: %empty  */
 #line 112 "grammar.y"
-    {(yyval.exop) = new FalseExtendsOption(); (yyval.exop)->setLineno((yyloc).first_line);;}
+                            {(yyval.exop) = new FalseExtendsOption(); (yyval.exop)->setLineno((yyloc).first_line);}
+#line 1377 "grammar.tab.c"
     break;
 
-  case 8:
+  case 8: /* extends_option: EXTENDS IDENT  */
 #line 113 "grammar.y"
-    {(yyval.exop) = new TrueExtendsOption((yyvsp[(2) - (2)].id)); (yyval.exop)->setLineno((yyloc).first_line);;}
+                            {(yyval.exop) = new TrueExtendsOption((yyvsp[0].id)); (yyval.exop)->setLineno((yyloc).first_line);}
+#line 1383 "grammar.tab.c"
     break;
 
-  case 9:
+  case 9: /* formal_args: %empty  */
 #line 117 "grammar.y"
-    {(yyval.fargs) = new std::list<FormalArg *>();;}
+                            {(yyval.fargs) = new NodeList<FormalArg *>();}
+#line 1389 "grammar.tab.c"
     break;
 
-  case 10:
+  case 10: /* formal_args: formal_arg_list  */
 #line 118 "grammar.y"
-    {(yyval.fargs) = (yyvsp[(2) - (2)].fargs); (yyvsp[(2) - (2)].fargs)->push_front((yyvsp[(1) - (2)].farg));;}
+                              {(yyval.fargs) = (yyvsp[0].fargs);}
+#line 1395 "grammar.tab.c"
     break;
 
-  case 11:
+  case 11: /* formal_arg: IDENT ':' IDENT  */
 #line 122 "grammar.y"
-    {(yyval.farg) = new FormalArg((yyvsp[(1) - (3)].id), (yyvsp[(3) - (3)].id)); (yyval.farg)->setLineno((yyloc).first_line);;}
+                          {(yyval.farg) = new FormalArg((yyvsp[-2].id), (yyvsp[0].id)); (yyval.farg)->setLineno((yyloc).first_line);}
+#line 1401 "grammar.tab.c"
     break;
 
-  case 12:
-#line 126 "grammar.y"
-    {(yyval.fargs) = new std::list<FormalArg *>();;}
-    break;
-
-  case 13:
+  case 12: /* formal_arg_list: formal_arg  */
 #line 127 "grammar.y"
-    {(yyval.fargs) = (yyvsp[(1) - (3)].fargs); (yyvsp[(1) - (3)].fargs)->push_back((yyvsp[(3) - (3)].farg));;}
+                             {(yyval.fargs) = new NodeList<FormalArg *>(); (yyval.fargs)->push_back((yyvsp[0].farg));}
+#line 1407 "grammar.tab.c"
     break;
 
-  case 14:
-#line 131 "grammar.y"
-    {(yyval.clsbdy) = new ClassBody((yyvsp[(2) - (4)].stmts), (yyvsp[(3) - (4)].meths)); (yyval.clsbdy)->setLineno((yyloc).first_line);;}
+  case 13: /* formal_arg_list: formal_arg_list ',' formal_arg  */
+#line 128 "grammar.y"
+                                                 {(yyval.fargs) = (yyvsp[-2].fargs); (yyvsp[-2].fargs)->push_back((yyvsp[0].farg));}
+#line 1413 "grammar.tab.c"
     break;
 
-  case 15:
-#line 134 "grammar.y"
-    {(yyval.meth) = new Method((yyvsp[(2) - (7)].id), (yyvsp[(4) - (7)].fargs), (yyvsp[(6) - (7)].idop), (yyvsp[(7) - (7)].stmts)); (yyval.meth)->setLineno((yyloc).first_line);;}
+  case 14: /* class_body: '{' statement_star method_star '}'  */
+#line 132 "grammar.y"
+                                             {(yyval.clsbdy) = new ClassBody((yyvsp[-2].stmts), (yyvsp[-1].meths)); (yyval.clsbdy)->setLineno((yyloc).first_line);}
+#line 1419 "grammar.tab.c"
     break;
 
-  case 16:
-#line 138 "grammar.y"
-    {(yyval.meths) = new std::list<Method *>();;}
+  case 15: /* method: DEF IDENT '(' formal_args ')' ident_option statement_block  */
+#line 135 "grammar.y"
+                                                                  {(yyval.meth) = new Method((yyvsp[-5].id), (yyvsp[-3].fargs), (yyvsp[-1].idop), (yyvsp[0].stmts)); (yyval.meth)->setLineno((yyloc).first_line);}
+#line 1425 "grammar.tab.c"
     break;
 
-  case 17:
+  case 16: /* method_star: %empty  */
 #line 139 "grammar.y"
-    {(yyval.meths) = (yyvsp[(1) - (2)].meths); (yyvsp[(1) - (2)].meths)->push_back((yyvsp[(2) - (2)].meth));;}
+                             {(yyval.meths) = new NodeList<Method *>();}
+#line 1431 "grammar.tab.c"
     break;
 
-  case 18:
-#line 143 "grammar.y"
-    {(yyval.idop) = new FalseIdentOption(); (yyval.idop)->setLineno((yyloc).first_line);;}
+  case 17: /* method_star: method_star method  */
+#line 140 "grammar.y"
+                             {(yyval.meths) = (yyvsp[-1].meths); (yyvsp[-1].meths)->push_back((yyvsp[0].meth));}
+#line 1437 "grammar.tab.c"
     break;
 
-  case 19:
+  case 18: /* ident_option: %empty  */
 #line 144 "grammar.y"
-    {(yyval.idop) = new TrueIdentOption((yyvsp[(2) - (2)].id)); (yyval.idop)->setLineno((yyloc).first_line);;}
+                        {(yyval.idop) = new FalseIdentOption(); (yyval.idop)->setLineno((yyloc).first_line);}
+#line 1443 "grammar.tab.c"
     break;
 
-  case 20:
-#line 148 "grammar.y"
-    {(yyval.stmts) = new std::list<Statement *>();;}
+  case 19: /* ident_option: ':' IDENT  */
+#line 145 "grammar.y"
+                        {(yyval.idop) = new TrueIdentOption((yyvsp[0].id)); (yyval.idop)->setLineno((yyloc).first_line);}
+#line 1449 "grammar.tab.c"
     break;
 
-  case 21:
+  case 20: /* statement_star: %empty  */
 #line 149 "grammar.y"
-    {(yyval.stmts) = (yyvsp[(1) - (2)].stmts); (yyvsp[(1) - (2)].stmts)->push_back((yyvsp[(2) - (2)].stmt));;}
+                                   {(yyval.stmts) = new NodeList<Statement *>();}
+#line 1455 "grammar.tab.c"
     break;
 
-  case 22:
-#line 153 "grammar.y"
-    {(yyval.stmts) = (yyvsp[(2) - (3)].stmts);;}
+  case 21: /* statement_star: statement_star statement  */
+#line 150 "grammar.y"
+                                   {(yyval.stmts) = (yyvsp[-1].stmts); (yyvsp[-1].stmts)->push_back((yyvsp[0].stmt));}
+#line 1461 "grammar.tab.c"
     break;
 
-  case 23:
-#line 157 "grammar.y"
-    {(yyval.stmt) = new IfBlock((yyvsp[(1) - (3)]._if), (yyvsp[(2) - (3)].elifs), (yyvsp[(3) - (3)]._else)); (yyval.stmt)->setLineno((yyloc).first_line);;}
+  case 22: /* statement_block: '{' statement_star '}'  */
+#line 154 "grammar.y"
+                                        {(yyval.stmts) = (yyvsp[-1].stmts);}
+#line 1467 "grammar.tab.c"
     break;
 
-  case 24:
+  case 23: /* statement: if_clause elif_star else_option  */
 #line 158 "grammar.y"
-    {(yyval.stmt) = new WhileStatement((yyvsp[(2) - (3)].rexpr), (yyvsp[(3) - (3)].stmts)); (yyval.stmt)->setLineno((yyloc).first_line);;}
+                                             {(yyval.stmt) = new IfBlock((yyvsp[-2]._if), (yyvsp[-1].elifs), (yyvsp[0]._else)); (yyval.stmt)->setLineno((yyloc).first_line);}
+#line 1473 "grammar.tab.c"
     break;
 
-  case 25:
+  case 24: /* statement: WHILE r_expr statement_block  */
 #line 159 "grammar.y"
-    {(yyval.stmt) = new AssignmentStatement((yyvsp[(1) - (5)].lexpr), (yyvsp[(2) - (5)].idop), (yyvsp[(4) - (5)].rexpr)); (yyval.stmt)->setLineno((yyloc).first_line);;}
+                                             {(yyval.stmt) = new WhileStatement((yyvsp[-1].rexpr), (yyvsp[0].stmts)); (yyval.stmt)->setLineno((yyloc).first_line);}
+#line 1479 "grammar.tab.c"
     break;
 
-  case 26:
+  case 25: /* statement: l_expr ident_option '=' r_expr ';'  */
 #line 160 "grammar.y"
-    {(yyval.stmt) = new ReturnStatement((yyvsp[(2) - (3)].rexpr)); (yyval.stmt)->setLineno((yyloc).first_line);;}
+                                             {(yyval.stmt) = new AssignmentStatement((yyvsp[-4].lexpr), (yyvsp[-3].idop), (yyvsp[-1].rexpr)); (yyval.stmt)->setLineno((yyloc).first_line);}
+#line 1485 "grammar.tab.c"
     break;
 
-  case 27:
+  case 26: /* statement: RETURN r_expr_option ';'  */
 #line 161 "grammar.y"
-    {(yyval.stmt) = new RExprStatement((yyvsp[(1) - (2)].rexpr)); (yyval.stmt)->setLineno((yyloc).first_line);;}
+                                             {(yyval.stmt) = new ReturnStatement((yyvsp[-1].rexpr)); (yyval.stmt)->setLineno((yyloc).first_line);}
+#line 1491 "grammar.tab.c"
     break;
 
-  case 28:
-#line 165 "grammar.y"
-    {(yyval._if) = new IfClause((yyvsp[(2) - (3)].rexpr), (yyvsp[(3) - (3)].stmts)); (yyval._if)->setLineno((yyloc).first_line);;}
+  case 27: /* statement: r_expr ';'  */
+#line 162 "grammar.y"
+                                             {(yyval.stmt) = new RExprStatement((yyvsp[-1].rexpr)); (yyval.stmt)->setLineno((yyloc).first_line);}
+#line 1497 "grammar.tab.c"
     break;
 
-  case 29:
-#line 169 "grammar.y"
-    {(yyval.elifs) = new std::list<ElifClause *>();;}
+  case 28: /* if_clause: IF r_expr statement_block  */
+#line 166 "grammar.y"
+                              {(yyval._if) = new IfClause((yyvsp[-1].rexpr), (yyvsp[0].stmts)); (yyval._if)->setLineno((yyloc).first_line);}
+#line 1503 "grammar.tab.c"
     break;
 
-  case 30:
+  case 29: /* elif_star: %empty  */
 #line 170 "grammar.y"
-    {(yyval.elifs) = (yyvsp[(1) - (2)].elifs); (yyvsp[(1) - (2)].elifs)->push_back((yyvsp[(2) - (2)]._elif));;}
+                                {(yyval.elifs) = new NodeList<ElifClause *>();}
+#line 1509 "grammar.tab.c"
     break;
 
-  case 31:
-#line 174 "grammar.y"
-    {(yyval._elif) = new ElifClause((yyvsp[(2) - (3)].rexpr), (yyvsp[(3) - (3)].stmts)); (yyval._elif)->setLineno((yyloc).first_line);;}
+  case 30: /* elif_star: elif_star elif_clause  */
+#line 171 "grammar.y"
+                                {(yyval.elifs) = (yyvsp[-1].elifs); (yyvsp[-1].elifs)->push_back((yyvsp[0]._elif));}
+#line 1515 "grammar.tab.c"
     break;
 
-  case 32:
-#line 178 "grammar.y"
-    {(yyval._else) = new FalseElseOption(); (yyval._else)->setLineno((yyloc).first_line);;}
+  case 31: /* elif_clause: ELIF r_expr statement_block  */
+#line 175 "grammar.y"
+                                      {(yyval._elif) = new ElifClause((yyvsp[-1].rexpr), (yyvsp[0].stmts)); (yyval._elif)->setLineno((yyloc).first_line);}
+#line 1521 "grammar.tab.c"
     break;
 
-  case 33:
+  case 32: /* else_option: %empty  */
 #line 179 "grammar.y"
-    {(yyval._else) = new TrueElseOption((yyvsp[(2) - (2)].stmts)); (yyval._else)->setLineno((yyloc).first_line);;}
+                                   {(yyval._else) = new FalseElseOption(); (yyval._else)->setLineno((yyloc).first_line);}
+#line 1527 "grammar.tab.c"
     break;
 
-  case 34:
-#line 183 "grammar.y"
-    {(yyval.lexpr) = new IdentNode((yyvsp[(1) - (1)].id)); (yyval.lexpr)->setLineno((yyloc).first_line);;}
+  case 33: /* else_option: ELSE statement_block  */
+#line 180 "grammar.y"
+                                   {(yyval._else) = new TrueElseOption((yyvsp[0].stmts)); (yyval._else)->setLineno((yyloc).first_line);}
+#line 1533 "grammar.tab.c"
     break;
 
-  case 35:
+  case 34: /* l_expr: IDENT  */
 #line 184 "grammar.y"
-    {(yyval.lexpr) = new ObjectFieldLExpr((yyvsp[(1) - (3)].rexpr), (yyvsp[(3) - (3)].id)); (yyval.lexpr)->setLineno((yyloc).first_line);;}
+                       {(yyval.lexpr) = new IdentNode((yyvsp[0].id)); (yyval.lexpr)->setLineno((yyloc).first_line);}
+#line 1539 "grammar.tab.c"
     break;
 
-  case 36:
-#line 188 "grammar.y"
-    {(yyval.rexpr) = new StringNode((yyvsp[(1) - (1)].id)); (yyval.rexpr)->setLineno((yyloc).first_line);;}
+  case 35: /* l_expr: r_expr '.' IDENT  */
+#line 185 "grammar.y"
+                       {(yyval.lexpr) = new ObjectFieldLExpr((yyvsp[-2].rexpr), (yyvsp[0].id)); (yyval.lexpr)->setLineno((yyloc).first_line);}
+#line 1545 "grammar.tab.c"
     break;
 
-  case 37:
+  case 36: /* r_expr: STRING_LIT  */
 #line 189 "grammar.y"
-    {(yyval.rexpr) = new IntNode((yyvsp[(1) - (1)].integer)); (yyval.rexpr)->setLineno((yyloc).first_line);;}
+                 {(yyval.rexpr) = new StringNode((yyvsp[0].id)); (yyval.rexpr)->setLineno((yyloc).first_line);}
+#line 1551 "grammar.tab.c"
     break;
 
-  case 38:
+  case 37: /* r_expr: INT_LIT  */
 #line 190 "grammar.y"
-    {(yyval.rexpr) = new RExprToLExpr((yyvsp[(1) - (1)].lexpr)); (yyval.rexpr)->setLineno((yyloc).first_line);;}
+                 {(yyval.rexpr) = new IntNode((yyvsp[0].integer)); (yyval.rexpr)->setLineno((yyloc).first_line);}
+#line 1557 "grammar.tab.c"
     break;
 
-  case 39:
+  case 38: /* r_expr: l_expr  */
 #line 191 "grammar.y"
-    {(yyval.rexpr) = new PlusNode((yyvsp[(1) - (3)].rexpr), (yyvsp[(3) - (3)].rexpr)); (yyval.rexpr)->setLineno((yyloc).first_line);;}
+                 {(yyval.rexpr) = new RExprToLExpr((yyvsp[0].lexpr)); (yyval.rexpr)->setLineno((yyloc).first_line);}
+#line 1563 "grammar.tab.c"
     break;
 
-  case 40:
+  case 39: /* r_expr: r_expr '+' r_expr  */
 #line 192 "grammar.y"
-    {(yyval.rexpr) = new MinusNode((yyvsp[(1) - (3)].rexpr), (yyvsp[(3) - (3)].rexpr)); (yyval.rexpr)->setLineno((yyloc).first_line);;}
+                        {(yyval.rexpr) = new PlusNode((yyvsp[-2].rexpr), (yyvsp[0].rexpr)); (yyval.rexpr)->setLineno((yyloc).first_line);}
+#line 1569 "grammar.tab.c"
     break;
 
-  case 41:
+  case 40: /* r_expr: r_expr '-' r_expr  */
 #line 193 "grammar.y"
-    {(yyval.rexpr) = new TimesNode((yyvsp[(1) - (3)].rexpr), (yyvsp[(3) - (3)].rexpr)); (yyval.rexpr)->setLineno((yyloc).first_line);;}
+                        {(yyval.rexpr) = new MinusNode((yyvsp[-2].rexpr), (yyvsp[0].rexpr)); (yyval.rexpr)->setLineno((yyloc).first_line);}
+#line 1575 "grammar.tab.c"
     break;
 
-  case 42:
+  case 41: /* r_expr: r_expr '*' r_expr  */
 #line 194 "grammar.y"
-    {(yyval.rexpr) = new DivideNode((yyvsp[(1) - (3)].rexpr), (yyvsp[(3) - (3)].rexpr)); (yyval.rexpr)->setLineno((yyloc).first_line);;}
+                        {(yyval.rexpr) = new TimesNode((yyvsp[-2].rexpr), (yyvsp[0].rexpr)); (yyval.rexpr)->setLineno((yyloc).first_line);}
+#line 1581 "grammar.tab.c"
     break;
 
-  case 43:
+  case 42: /* r_expr: r_expr '/' r_expr  */
 #line 195 "grammar.y"
-    {(yyval.rexpr) = (yyvsp[(2) - (3)].rexpr);;}
+                        {(yyval.rexpr) = new DivideNode((yyvsp[-2].rexpr), (yyvsp[0].rexpr)); (yyval.rexpr)->setLineno((yyloc).first_line);}
+#line 1587 "grammar.tab.c"
     break;
 
-  case 44:
+  case 43: /* r_expr: '(' r_expr ')'  */
 #line 196 "grammar.y"
-    {(yyval.rexpr) = new EqualsNode((yyvsp[(1) - (3)].rexpr), (yyvsp[(3) - (3)].rexpr)); (yyval.rexpr)->setLineno((yyloc).first_line);;}
+                        {(yyval.rexpr) = (yyvsp[-1].rexpr);}
+#line 1593 "grammar.tab.c"
     break;
 
-  case 45:
+  case 44: /* r_expr: r_expr EQUALS r_expr  */
 #line 197 "grammar.y"
-    {(yyval.rexpr) = new AtMostNode((yyvsp[(1) - (3)].rexpr), (yyvsp[(3) - (3)].rexpr)); (yyval.rexpr)->setLineno((yyloc).first_line);;}
+                            {(yyval.rexpr) = new EqualsNode((yyvsp[-2].rexpr), (yyvsp[0].rexpr)); (yyval.rexpr)->setLineno((yyloc).first_line);}
+#line 1599 "grammar.tab.c"
     break;
 
-  case 46:
+  case 45: /* r_expr: r_expr ATMOST r_expr  */
 #line 198 "grammar.y"
-    {(yyval.rexpr) = new LessThanNode((yyvsp[(1) - (3)].rexpr), (yyvsp[(3) - (3)].rexpr)); (yyval.rexpr)->setLineno((yyloc).first_line);;}
+                            {(yyval.rexpr) = new AtMostNode((yyvsp[-2].rexpr), (yyvsp[0].rexpr)); (yyval.rexpr)->setLineno((yyloc).first_line);}
+#line 1605 "grammar.tab.c"
     break;
 
-  case 47:
+  case 46: /* r_expr: r_expr '<' r_expr  */
 #line 199 "grammar.y"
-    {(yyval.rexpr) = new AtLeastNode((yyvsp[(1) - (3)].rexpr), (yyvsp[(3) - (3)].rexpr)); (yyval.rexpr)->setLineno((yyloc).first_line);;}
+                            {(yyval.rexpr) = new LessThanNode((yyvsp[-2].rexpr), (yyvsp[0].rexpr)); (yyval.rexpr)->setLineno((yyloc).first_line);}
+#line 1611 "grammar.tab.c"
     break;
 
-  case 48:
+  case 47: /* r_expr: r_expr ATLEAST r_expr  */
 #line 200 "grammar.y"
-    {(yyval.rexpr) = new GreaterThanNode((yyvsp[(1) - (3)].rexpr), (yyvsp[(3) - (3)].rexpr)); (yyval.rexpr)->setLineno((yyloc).first_line);;}
+                            {(yyval.rexpr) = new AtLeastNode((yyvsp[-2].rexpr), (yyvsp[0].rexpr)); (yyval.rexpr)->setLineno((yyloc).first_line);}
+#line 1617 "grammar.tab.c"
     break;
 
-  case 49:
+  case 48: /* r_expr: r_expr '>' r_expr  */
 #line 201 "grammar.y"
-    {(yyval.rexpr) = new AndNode((yyvsp[(1) - (3)].rexpr), (yyvsp[(3) - (3)].rexpr)); (yyval.rexpr)->setLineno((yyloc).first_line);;}
+                            {(yyval.rexpr) = new GreaterThanNode((yyvsp[-2].rexpr), (yyvsp[0].rexpr)); (yyval.rexpr)->setLineno((yyloc).first_line);}
+#line 1623 "grammar.tab.c"
     break;
 
-  case 50:
+  case 49: /* r_expr: r_expr AND r_expr  */
 #line 202 "grammar.y"
-    {(yyval.rexpr) = new OrNode((yyvsp[(1) - (3)].rexpr), (yyvsp[(3) - (3)].rexpr)); (yyval.rexpr)->setLineno((yyloc).first_line);;}
+                            {(yyval.rexpr) = new AndNode((yyvsp[-2].rexpr), (yyvsp[0].rexpr)); (yyval.rexpr)->setLineno((yyloc).first_line);}
+#line 1629 "grammar.tab.c"
     break;
 
-  case 51:
+  case 50: /* r_expr: r_expr OR r_expr  */
 #line 203 "grammar.y"
-    {(yyval.rexpr) = new NotNode((yyvsp[(2) - (2)].rexpr)); (yyval.rexpr)->setLineno((yyloc).first_line);;}
+                            {(yyval.rexpr) = new OrNode((yyvsp[-2].rexpr), (yyvsp[0].rexpr)); (yyval.rexpr)->setLineno((yyloc).first_line);}
+#line 1635 "grammar.tab.c"
     break;
 
-  case 52:
+  case 51: /* r_expr: NOT r_expr  */
 #line 204 "grammar.y"
-    {(yyval.rexpr) = new DotRExpr((yyvsp[(1) - (6)].rexpr), (yyvsp[(3) - (6)].id), (yyvsp[(5) - (6)].rexprs)); (yyval.rexpr)->setLineno((yyloc).first_line);;}
+                            {(yyval.rexpr) = new NotNode((yyvsp[0].rexpr)); (yyval.rexpr)->setLineno((yyloc).first_line);}
+#line 1641 "grammar.tab.c"
     break;
 
-  case 53:
+  case 52: /* r_expr: r_expr '.' IDENT '(' actual_args ')'  */
 #line 205 "grammar.y"
-    {(yyval.rexpr) = new ConstructorRExpr((yyvsp[(1) - (4)].id), (yyvsp[(3) - (4)].rexprs)); (yyval.rexpr)->setLineno((yyloc).first_line);;}
+                                           {(yyval.rexpr) = new DotRExpr((yyvsp[-5].rexpr), (yyvsp[-3].id), (yyvsp[-1].rexprs)); (yyval.rexpr)->setLineno((yyloc).first_line);}
+#line 1647 "grammar.tab.c"
     break;
 
-  case 54:
-#line 209 "grammar.y"
-    {(yyval.rexpr) = new EmptyRExpr(); (yyval.rexpr)->setLineno((yyloc).first_line);;}
+  case 53: /* r_expr: IDENT '(' actual_args ')'  */
+#line 206 "grammar.y"
+                                {(yyval.rexpr) = new ConstructorRExpr((yyvsp[-3].id), (yyvsp[-1].rexprs)); (yyval.rexpr)->setLineno((yyloc).first_line);}
+#line 1653 "grammar.tab.c"
     break;
 
-  case 55:
+  case 54: /* r_expr_option: %empty  */
 #line 210 "grammar.y"
-    {(yyval.rexpr) = (yyvsp[(1) - (1)].rexpr);;}
+                            {(yyval.rexpr) = new EmptyRExpr(); (yyval.rexpr)->setLineno((yyloc).first_line);}
+#line 1659 "grammar.tab.c"
     break;
 
-  case 56:
-#line 214 "grammar.y"
-    {(yyval.rexprs) = new std::list<RExpr *>();;}
+  case 55: /* r_expr_option: r_expr  */
+#line 211 "grammar.y"
+                            {(yyval.rexpr) = (yyvsp[0].rexpr);}
+#line 1665 "grammar.tab.c"
     break;
 
-  case 57:
+  case 56: /* actual_args: %empty  */
 #line 215 "grammar.y"
-    {(yyval.rexprs) = new std::list<RExpr *>(); (yyval.rexprs)->push_back((yyvsp[(1) - (2)].rexpr)); (yyval.rexprs)->merge(*((yyvsp[(2) - (2)].rexprs)));;}
+                                    {(yyval.rexprs) = new NodeList<RExpr *>();}
+#line 1671 "grammar.tab.c"
     break;
 
-  case 58:
-#line 219 "grammar.y"
-    {(yyval.rexprs) = new std::list<RExpr *>();;}
+  case 57: /* actual_args: actual_arg_list  */
+#line 216 "grammar.y"
+                                    {(yyval.rexprs) = (yyvsp[0].rexprs);}
+#line 1677 "grammar.tab.c"
     break;
 
-  case 59:
+  case 58: /* actual_arg_list: r_expr  */
 #line 220 "grammar.y"
-    {(yyval.rexprs) = (yyvsp[(1) - (3)].rexprs); (yyvsp[(1) - (3)].rexprs)->push_back((yyvsp[(3) - (3)].rexpr));;}
+                                             {(yyval.rexprs) = new NodeList<RExpr *>(); (yyval.rexprs)->push_back((yyvsp[0].rexpr));}
+#line 1683 "grammar.tab.c"
+    break;
+
+  case 59: /* actual_arg_list: actual_arg_list ',' r_expr  */
+#line 221 "grammar.y"
+                                             {(yyval.rexprs) = (yyvsp[-2].rexprs); (yyvsp[-2].rexprs)->push_back((yyvsp[0].rexpr));}
+#line 1689 "grammar.tab.c"
     break;
 
 
-/* Line 1267 of yacc.c.  */
-#line 1830 "grammar.tab.c"
+#line 1693 "grammar.tab.c"
+
       default: break;
     }
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
   *++yylsp = yyloc;
 
-  /* Now `shift' the result of the reduction.  Determine what state
+  /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
 
-/*------------------------------------.
-| yyerrlab -- here on detecting error |
-`------------------------------------*/
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
 yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
       yyerror (YY_("syntax error"));
-#else
-      {
-	YYSIZE_T yysize = yysyntax_error (0, yystate, yychar);
-	if (yymsg_alloc < yysize && yymsg_alloc < YYSTACK_ALLOC_MAXIMUM)
-	  {
-	    YYSIZE_T yyalloc = 2 * yysize;
-	    if (! (yysize <= yyalloc && yyalloc <= YYSTACK_ALLOC_MAXIMUM))
-	      yyalloc = YYSTACK_ALLOC_MAXIMUM;
-	    if (yymsg != yymsgbuf)
-	      YYSTACK_FREE (yymsg);
-	    yymsg = (char *) YYSTACK_ALLOC (yyalloc);
-	    if (yymsg)
-	      yymsg_alloc = yyalloc;
-	    else
-	      {
-		yymsg = yymsgbuf;
-		yymsg_alloc = sizeof yymsgbuf;
-	      }
-	  }
-
-	if (0 < yysize && yysize <= yymsg_alloc)
-	  {
-	    (void) yysyntax_error (yymsg, yystate, yychar);
-	    yyerror (yymsg);
-	  }
-	else
-	  {
-	    yyerror (YY_("syntax error"));
-	    if (yysize != 0)
-	      goto yyexhaustedlab;
-	  }
-      }
-#endif
     }
 
-  yyerror_range[0] = yylloc;
-
+  yyerror_range[1] = yylloc;
   if (yyerrstatus == 3)
     {
-      /* If just tried and failed to reuse look-ahead token after an
-	 error, discard it.  */
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
 
       if (yychar <= YYEOF)
-	{
-	  /* Return failure if at end of input.  */
-	  if (yychar == YYEOF)
-	    YYABORT;
-	}
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
       else
-	{
-	  yydestruct ("Error: discarding",
-		      yytoken, &yylval, &yylloc);
-	  yychar = YYEMPTY;
-	}
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval, &yylloc);
+          yychar = YYEMPTY;
+        }
     }
 
-  /* Else will try to reuse look-ahead token after shifting the error
+  /* Else will try to reuse lookahead token after shifting the error
      token.  */
   goto yyerrlab1;
 
@@ -1928,15 +1769,13 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
-
-  yyerror_range[0] = yylsp[1-yylen];
-  /* Do not reclaim the symbols of the rule which action triggered
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
   YYPOPSTACK (yylen);
   yylen = 0;
@@ -1949,47 +1788,45 @@ yyerrorlab:
 | yyerrlab1 -- common code for both syntax error and YYERROR.  |
 `-------------------------------------------------------------*/
 yyerrlab1:
-  yyerrstatus = 3;	/* Each real token shifted decrements this.  */
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
-      if (yyn != YYPACT_NINF)
-	{
-	  yyn += YYTERROR;
-	  if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
-	    {
-	      yyn = yytable[yyn];
-	      if (0 < yyn)
-		break;
-	    }
-	}
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
 
       /* Pop the current state because it cannot handle the error token.  */
       if (yyssp == yyss)
-	YYABORT;
+        YYABORT;
 
-      yyerror_range[0] = *yylsp;
+      yyerror_range[1] = *yylsp;
       yydestruct ("Error: popping",
-		  yystos[yystate], yyvsp, yylsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, yylsp);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
     }
 
-  if (yyn == YYFINAL)
-    YYACCEPT;
-
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 
-  yyerror_range[1] = yylloc;
-  /* Using YYLLOC is tempting, but would change the location of
-     the look-ahead.  YYLOC is available though.  */
-  YYLLOC_DEFAULT (yyloc, (yyerror_range - 1), 2);
-  *++yylsp = yyloc;
+  yyerror_range[2] = yylloc;
+  ++yylsp;
+  YYLLOC_DEFAULT (*yylsp, yyerror_range, 2);
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2000,57 +1837,60 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
-#ifndef yyoverflow
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
   yyerror (YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
+
 
-yyreturn:
-  if (yychar != YYEOF && yychar != YYEMPTY)
-     yydestruct ("Cleanup: discarding lookahead",
-		 yytoken, &yylval, &yylloc);
-  /* Do not reclaim the symbols of the rule which action triggered
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval, &yylloc);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
   YYPOPSTACK (yylen);
   YY_STACK_PRINT (yyss, yyssp);
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-		  yystos[*yyssp], yyvsp, yylsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, yylsp);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
-  /* Make sure YYID is used.  */
-  return YYID (yyresult);
+
+  return yyresult;
 }
 
-
-#line 221 "grammar.y"
+#line 222 "grammar.y"
 
 
 /*
 // main has been moved to it's own driver file
 int main(int argc, char* argv[]) {}
 */
-
@@ -1,14 +1,14 @@
-/* A Bison parser, made by GNU Bison 2.3.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
-/* Skeleton interface for Bison's Yacc-like parsers in C
+/* Bison interface for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989, 1990, 2000, 2001, 2002, 2003, 2004, 2005, 2006
-   Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
-   This program is free software; you can redistribute it and/or modify
+   This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
-   the Free Software Foundation; either version 2, or (at your option)
-   any later version.
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
 
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
@@ -16,9 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program; if not, write to the Free Software
-   Foundation, Inc., 51 Franklin Street, Fifth Floor,
-   Boston, MA 02110-1301, USA.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -33,65 +31,64 @@
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
-/* Tokens.  */
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+#ifndef YY_YY_GRAMMAR_TAB_H_INCLUDED
+# define YY_YY_GRAMMAR_TAB_H_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 0
+#endif
+#if YYDEBUG
+extern int yydebug;
+#endif
+
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     INT_LIT = 258,
-     STRING_LIT = 259,
-     IDENT = 260,
-     CLASS = 261,
-     DEF = 262,
-     EXTENDS = 263,
-     IF = 264,
-     ELIF = 265,
-     ELSE = 266,
-     WHILE = 267,
-     RETURN = 268,
-     ATLEAST = 269,
-     ATMOST = 270,
-     EQUALS = 271,
-     AND = 272,
-     OR = 273,
-     NOT = 274
-   };
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    INT_LIT = 258,                 /* INT_LIT  */
+    STRING_LIT = 259,              /* STRING_LIT  */
+    IDENT = 260,                   /* IDENT  */
+    CLASS = 261,                   /* CLASS  */
+    DEF = 262,                     /* DEF  */
+    EXTENDS = 263,                 /* EXTENDS  */
+    IF = 264,                      /* IF  */
+    ELIF = 265,                    /* ELIF  */
+    ELSE = 266,                    /* ELSE  */
+    WHILE = 267,                   /* WHILE  */
+    RETURN = 268,                  /* RETURN  */
+    ATLEAST = 269,                 /* ATLEAST  */
+    ATMOST = 270,                  /* ATMOST  */
+    EQUALS = 271,                  /* EQUALS  */
+    AND = 272,                     /* AND  */
+    OR = 273,                      /* OR  */
+    NOT = 274                      /* NOT  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
-/* Tokens.  */
-#define INT_LIT 258
-#define STRING_LIT 259
-#define IDENT 260
-#define CLASS 261
-#define DEF 262
-#define EXTENDS 263
-#define IF 264
-#define ELIF 265
-#define ELSE 266
-#define WHILE 267
-#define RETURN 268
-#define ATLEAST 269
-#define ATMOST 270
-#define EQUALS 271
-#define AND 272
-#define OR 273
-#define NOT 274
-
-
-
 
+/* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
-#line 33 "grammar.y"
+union YYSTYPE
 {
+#line 33 "grammar.y"
+
     int integer;
     char *id;
-    std::list<Statement *> *stmts;
-    std::list<Class *>     *clsss; 
-    std::list<RExpr *> *rexprs;
-    std::list<ElifClause *> *elifs;
-    std::list<FormalArg *> *fargs;
-    std::list<Method *> *meths;
+    NodeList<Statement *> *stmts;
+    NodeList<Class *>     *clsss; 
+    NodeList<RExpr *> *rexprs;
+    NodeList<ElifClause *> *elifs;
+    NodeList<FormalArg *> *fargs;
+    NodeList<Method *> *meths;
     Class *cls;
     ClassBody *clsbdy;
     ClassSignature *clssig;
@@ -107,28 +104,34 @@ typedef union YYSTYPE
     LExpr *lexpr;
     Program *pgm;
 
-}
-/* Line 1529 of yacc.c.  */
-#line 113 "grammar.tab.h"
-	YYSTYPE;
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
-# define YYSTYPE_IS_DECLARED 1
+
+#line 109 "grammar.tab.h"
+
+};
+typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
 #endif
 
-extern YYSTYPE yylval;
-
+/* Location type.  */
 #if ! defined YYLTYPE && ! defined YYLTYPE_IS_DECLARED
-typedef struct YYLTYPE
+typedef struct YYLTYPE YYLTYPE;
+struct YYLTYPE
 {
   int first_line;
   int first_column;
   int last_line;
   int last_column;
-} YYLTYPE;
-# define yyltype YYLTYPE /* obsolescent; will be withdrawn */
+};
 # define YYLTYPE_IS_DECLARED 1
 # define YYLTYPE_IS_TRIVIAL 1
 #endif
 
+
+extern YYSTYPE yylval;
 extern YYLTYPE yylloc;
+
+int yyparse (void);
+
+
+#endif /* !YY_YY_GRAMMAR_TAB_H_INCLUDED  */
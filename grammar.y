@@ -33,12 +33,12 @@ Program *root;
 %union {
     int integer;
     char *id;
-    std::list<Statement *> *stmts;
-    std::list<Class *>     *clsss; 
-    std::list<RExpr *> *rexprs;
-    std::list<ElifClause *> *elifs;
-    std::list<FormalArg *> *fargs;
-    std::list<Method *> *meths;
+    NodeList<Statement *> *stmts;
+    NodeList<Class *>     *clsss; 
+    NodeList<RExpr *> *rexprs;
+    NodeList<ElifClause *> *elifs;
+    NodeList<FormalArg *> *fargs;
+    NodeList<Method *> *meths;
     Class *cls;
     ClassBody *clsbdy;
     ClassSignature *clssig;
@@ -77,7 +77,7 @@ Program *root;
 %type <meths> method_star
 %type <farg> formal_arg
 %type <fargs> formal_args
-%type <fargs> extra_formal_args_star
+%type <fargs> formal_arg_list
 %type <exop> extends_option
 %type <_if> if_clause
 %type <_elif> elif_clause
@@ -89,14 +89,14 @@ Program *root;
 %type <cls> class
 %type <clsss> class_star 
 %type <idop> ident_option
-%type <rexprs> actual_args extra_actual_args
+%type <rexprs> actual_args actual_arg_list
 %%
 program:
         class_star statement_star {$$ = new Program($1, $2, @$.first_line); $$->setLineno(@$.first_line); root = $$;}
         ;
 
 class_star: 
-            /* epsilon */    {$$ = new std::list<Class *>();}
+            /* epsilon */    {$$ = new NodeList<Class *>();}
           | class_star class {$$ = $1; $1->push_back($2);}
           ;
 
@@ -114,17 +114,18 @@ extends_option:
             ;
 
 formal_args: 
-             /* epsilon */  {$$ = new std::list<FormalArg *>();}
-           | formal_arg extra_formal_args_star  {$$ = $2; $2->push_front($1);} 
+             /* epsilon */  {$$ = new NodeList<FormalArg *>();}
+           | formal_arg_list  {$$ = $1;} 
            ;
 
 formal_arg:
           IDENT ':' IDENT {$$ = new FormalArg($1, $3); $$->setLineno(@$.first_line);}
         ;
 
-extra_formal_args_star: 
-                  /* epsilon */ {$$ = new std::list<FormalArg *>();}
-                | extra_formal_args_star ',' formal_arg {$$ = $1; $1->push_back($3);}  
+/* Left recursive, so each argument goes at the back of the list */
+formal_arg_list: 
+                  formal_arg {$$ = new NodeList<FormalArg *>(); $$->push_back($1);}
+                | formal_arg_list ',' formal_arg {$$ = $1; $1->push_back($3);}  
                 ;
 
 class_body:
@@ -135,7 +136,7 @@ method:
      ;
 
 method_star:
-          /* epsilon */      {$$ = new std::list<Method *>();}
+          /* epsilon */      {$$ = new NodeList<Method *>();}
         | method_star method {$$ = $1; $1->push_back($2);}
         ;
 
@@ -145,7 +146,7 @@ ident_option:
         ;
 
 statement_star: 
-          /* epsilon */            {$$ = new std::list<Statement *>();}
+          /* epsilon */            {$$ = new NodeList<Statement *>();}
         | statement_star statement {$$ = $1; $1->push_back($2);} 
         ;
 
@@ -166,7 +167,7 @@ if_clause:
     ;
 
 elif_star: 
-          /* epsilon */         {$$ = new std::list<ElifClause *>();}
+          /* epsilon */         {$$ = new NodeList<ElifClause *>();}
         | elif_star elif_clause {$$ = $1; $1->push_back($2);}
         ;
                 
@@ -211,13 +212,13 @@ r_expr_option:
             ;
 
 actual_args:
-           /* epsilon */            {$$ = new std::list<RExpr *>();}
-        |  r_expr extra_actual_args {$$ = new std::list<RExpr *>(); $$->push_back($1); $$->merge(*($2));}
+           /* epsilon */            {$$ = new NodeList<RExpr *>();}
+        |  actual_arg_list          {$$ = $1;}
         ;
 
-extra_actual_args:
-                  /* epsilon */                {$$ = new std::list<RExpr *>();}
-                | extra_actual_args ',' r_expr {$$ = $1; $1->push_back($3);}
+actual_arg_list:
+                  r_expr                     {$$ = new NodeList<RExpr *>(); $$->push_back($1);}
+                | actual_arg_list ',' r_expr {$$ = $1; $1->push_back($3);}
 %%
 
 /*
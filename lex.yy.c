@@ -590,6 +590,7 @@ char *yytext;
 #include <stdio.h>
 #include "nodes.hpp"
 #include "grammar.tab.h"
+#include "util.hpp"
 #define YY_USER_ACTION yylloc.first_line = yylloc.last_line = yylineno;
 
 void yyerror(const char *msg)
@@ -603,7 +604,7 @@ const char* BAD_NL_STR =
   "Unclosed string?  Encountered newline in quoted string.";
 
 
-#line 607 "lex.yy.c"
+#line 608 "lex.yy.c"
 
 #define INITIAL 0
 #define comment 1
@@ -787,10 +788,10 @@ YY_DECL
 	register char *yy_cp, *yy_bp;
 	register int yy_act;
     
-#line 32 "lexer.lex"
+#line 33 "lexer.lex"
 
 
-#line 794 "lex.yy.c"
+#line 795 "lex.yy.c"
 
 	if ( !(yy_init) )
 		{
@@ -885,167 +886,167 @@ do_action:	/* This label is used only to access EOF actions. */
 
 case 1:
 YY_RULE_SETUP
-#line 34 "lexer.lex"
+#line 35 "lexer.lex"
 {BEGIN(comment);}
 	YY_BREAK
 case 2:
 YY_RULE_SETUP
-#line 35 "lexer.lex"
+#line 36 "lexer.lex"
 ;
 	YY_BREAK
 case 3:
 YY_RULE_SETUP
-#line 36 "lexer.lex"
+#line 37 "lexer.lex"
 ;
 	YY_BREAK
 case 4:
 /* rule 4 can match eol */
 YY_RULE_SETUP
-#line 37 "lexer.lex"
+#line 38 "lexer.lex"
 ;
 	YY_BREAK
 case 5:
 YY_RULE_SETUP
-#line 38 "lexer.lex"
+#line 39 "lexer.lex"
 {BEGIN(INITIAL);}
 	YY_BREAK
 case 6:
 YY_RULE_SETUP
-#line 40 "lexer.lex"
+#line 41 "lexer.lex"
 {;}
 	YY_BREAK
 case 7:
 /* rule 7 can match eol */
 YY_RULE_SETUP
-#line 42 "lexer.lex"
+#line 43 "lexer.lex"
 {yylval.id = strdup(yytext); return STRING_LIT;}
 	YY_BREAK
 case 8:
 /* rule 8 can match eol */
 YY_RULE_SETUP
-#line 44 "lexer.lex"
+#line 45 "lexer.lex"
 {;}
 	YY_BREAK
 case 9:
 YY_RULE_SETUP
-#line 46 "lexer.lex"
+#line 47 "lexer.lex"
 {return CLASS;}
 	YY_BREAK
 case 10:
 YY_RULE_SETUP
-#line 47 "lexer.lex"
+#line 48 "lexer.lex"
 {return DEF;}
 	YY_BREAK
 case 11:
 YY_RULE_SETUP
-#line 48 "lexer.lex"
+#line 49 "lexer.lex"
 {return EXTENDS;}
 	YY_BREAK
 case 12:
 YY_RULE_SETUP
-#line 49 "lexer.lex"
+#line 50 "lexer.lex"
 {return IF;}
 	YY_BREAK
 case 13:
 YY_RULE_SETUP
-#line 50 "lexer.lex"
+#line 51 "lexer.lex"
 {return ELIF;}
 	YY_BREAK
 case 14:
 YY_RULE_SETUP
-#line 51 "lexer.lex"
+#line 52 "lexer.lex"
 {return ELSE;}
 	YY_BREAK
 case 15:
 YY_RULE_SETUP
-#line 52 "lexer.lex"
+#line 53 "lexer.lex"
 {return WHILE;}
 	YY_BREAK
 case 16:
 YY_RULE_SETUP
-#line 53 "lexer.lex"
+#line 54 "lexer.lex"
 {return RETURN;}
 	YY_BREAK
 case 17:
 YY_RULE_SETUP
-#line 54 "lexer.lex"
+#line 55 "lexer.lex"
 {return ATLEAST;}
 	YY_BREAK
 case 18:
 YY_RULE_SETUP
-#line 55 "lexer.lex"
+#line 56 "lexer.lex"
 {return ATMOST;}
 	YY_BREAK
 case 19:
 YY_RULE_SETUP
-#line 56 "lexer.lex"
+#line 57 "lexer.lex"
 {return EQUALS;}
 	YY_BREAK
 case 20:
 YY_RULE_SETUP
-#line 57 "lexer.lex"
+#line 58 "lexer.lex"
 {return AND;}
 	YY_BREAK
 case 21:
 YY_RULE_SETUP
-#line 58 "lexer.lex"
+#line 59 "lexer.lex"
 {return OR;}
 	YY_BREAK
 case 22:
 YY_RULE_SETUP
-#line 59 "lexer.lex"
+#line 60 "lexer.lex"
 {return NOT;}
 	YY_BREAK
 case 23:
 YY_RULE_SETUP
-#line 60 "lexer.lex"
+#line 61 "lexer.lex"
 {yylval.integer = atof(yytext); return INT_LIT;}
 	YY_BREAK
 case 24:
 YY_RULE_SETUP
-#line 62 "lexer.lex"
+#line 63 "lexer.lex"
 {return yytext[0];}
 	YY_BREAK
 case 25:
 YY_RULE_SETUP
-#line 63 "lexer.lex"
+#line 64 "lexer.lex"
 {yylval.id = strdup(yytext);       return STRING_LIT;}
 	YY_BREAK
 case 26:
 /* rule 26 can match eol */
 YY_RULE_SETUP
-#line 64 "lexer.lex"
+#line 65 "lexer.lex"
 {yylval.id = strdup(yytext); yyerror(BAD_ESC_MSG); return STRING_LIT;}
 	YY_BREAK
 case 27:
 /* rule 27 can match eol */
 YY_RULE_SETUP
-#line 65 "lexer.lex"
+#line 66 "lexer.lex"
 {yylval.id = strdup(yytext); yyerror(BAD_NL_STR);  return STRING_LIT;}
 	YY_BREAK
 case 28:
 YY_RULE_SETUP
-#line 66 "lexer.lex"
-{yylval.id = strdup(yytext); return IDENT;}
+#line 67 "lexer.lex"
+{yylval.id = intern(yytext, yyleng); return IDENT;}
 	YY_BREAK
 case YY_STATE_EOF(INITIAL):
 case YY_STATE_EOF(comment):
 case YY_STATE_EOF(triplequotes):
-#line 67 "lexer.lex"
+#line 68 "lexer.lex"
 {return EOF;}
 	YY_BREAK
 case 29:
 YY_RULE_SETUP
-#line 69 "lexer.lex"
+#line 70 "lexer.lex"
 { fprintf(stderr, "*** %d: Unexpected character %d (%c)\n",                                      
                     yylineno, (int) yytext[0], yytext[0]); }  
 	YY_BREAK
 case 30:
 YY_RULE_SETUP
-#line 72 "lexer.lex"
+#line 73 "lexer.lex"
 ECHO;
 	YY_BREAK
-#line 1049 "lex.yy.c"
+#line 1050 "lex.yy.c"
 
 	case YY_END_OF_BUFFER:
 		{
@@ -2052,7 +2053,7 @@ void yyfree (void * ptr )
 
 #define YYTABLES_NAME "yytables"
 
-#line 72 "lexer.lex"
+#line 73 "lexer.lex"
 
 
 
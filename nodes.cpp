@@ -19,6 +19,50 @@
 
 using std::list;
 
+Arena astArena;
+
+#define ARENA_BLOCK (256 * 1024)
+#define ARENA_ALIGN 16
+
+void *Arena::allocate(size_t size)
+{
+    size = (size + ARENA_ALIGN - 1) & ~(size_t) (ARENA_ALIGN - 1);
+    if (size > ARENA_BLOCK)
+    {
+        // A request too big for a block gets one of its own, kept behind
+        // the first block so what is left of that one still gets used
+        Block *b = (Block *) malloc(ARENA_ALIGN + size);
+        Block **at = blocks == NULL ? &blocks : &blocks->next;
+        b->next = *at;
+        *at = b;
+        return (char *) b + ARENA_ALIGN;
+    }
+    if (size > left)
+    {
+        Block *b = (Block *) malloc(ARENA_ALIGN + ARENA_BLOCK);
+        b->next = blocks;
+        blocks = b;
+        unused = (char *) b + ARENA_ALIGN;
+        left = ARENA_BLOCK;
+    }
+    void *p = unused;
+    unused += size;
+    left -= size;
+    return p;
+}
+
+void Arena::release()
+{
+    while (blocks != NULL)
+    {
+        Block *b = blocks;
+        blocks = b->next;
+        free(b);
+    }
+    unused = NULL;
+    left = 0;
+}
+
 Node::Node(int l) : lineno(l), st(NULL) {}
 void Node::setLineno(int l)
 {
@@ -45,7 +89,7 @@ char *Class::getExtends()
     return clssig->getExtends();
 }
 
-ClassSignature::ClassSignature(char *i, list<FormalArg *> *f, ExtendsOption *e) 
+ClassSignature::ClassSignature(char *i, NodeList<FormalArg *> *f, ExtendsOption *e) 
     : id(i), fargs(f), exop(e) {}
 void ClassSignature::print()
 {
@@ -76,7 +120,7 @@ void FalseExtendsOption::accept(Visitor *v)
 }
 char * FalseExtendsOption::getID()
 {
-    return (char *)"Obj";
+    return NAME_OBJ;
 }
 
 TrueExtendsOption::TrueExtendsOption(char *i) : id(i) {}
@@ -103,7 +147,7 @@ void FormalArg::accept(Visitor *v)
     v->visitFormalArg(this);
 }
 
-ClassBody::ClassBody(list<Statement *> *s, list<Method *> *m) : stmts(s), meths(m) {}
+ClassBody::ClassBody(NodeList<Statement *> *s, NodeList<Method *> *m) : stmts(s), meths(m) {}
 void ClassBody::print()
 {
     fprintf(stdout, "Found ClassBody\n");
@@ -113,7 +157,7 @@ void ClassBody::accept(Visitor *v)
     v->visitClassBody(this);
 }
 
-Method::Method(char *i, list<FormalArg *> *f, IdentOption *io, list<Statement *> *s) 
+Method::Method(char *i, NodeList<FormalArg *> *f, IdentOption *io, NodeList<Statement *> *s) 
     : id(i), fargs(f), ident(io), stmts(s) {}
 void Method::print()
 {
@@ -150,10 +194,11 @@ void TrueIdentOption::accept(Visitor *v)
 /*****************
  * RExpr classes *
  *****************/
+RExpr::RExpr() : resolvedType(NULL), resolvedIn(NULL), resolvedAt(0) {}
 RExpr::~RExpr() {}
 char *RExpr::type()
 {
-    return (char*)"-";
+    return NAME_UNKNOWN;
 }
 
 EmptyRExpr::EmptyRExpr() {}
@@ -167,10 +212,10 @@ void EmptyRExpr::accept(Visitor *v)
 }
 char *EmptyRExpr::type()
 {
-    return (char*)"Nothing";
+    return NAME_NOTHING;
 }
 
-DotRExpr::DotRExpr(RExpr *r, char *i, list<RExpr *> *a) : rexpr(r), id(i), args(a) {}
+DotRExpr::DotRExpr(RExpr *r, char *i, NodeList<RExpr *> *a) : rexpr(r), id(i), args(a) {}
 void DotRExpr::print()
 {
     fprintf(stdout, "Found DotRExpr\n");
@@ -180,7 +225,7 @@ void DotRExpr::accept(Visitor *v)
     v->visitDotRExpr(this);
 }
 
-ConstructorRExpr::ConstructorRExpr(char *i, list<RExpr *> *a) : id(i), args(a) {}
+ConstructorRExpr::ConstructorRExpr(char *i, NodeList<RExpr *> *a) : id(i), args(a), onStack(false) {}
 void ConstructorRExpr::print()
 {
     fprintf(stdout, "Found ConstructorRExpr\n");
@@ -215,7 +260,7 @@ void StringNode::accept(Visitor *v)
 }
 char *StringNode::type()
 {
-    return (char*)"String";
+    return NAME_STRING;
 }
 
 IntNode::IntNode(int i) : value(i) {}
@@ -229,7 +274,7 @@ void IntNode::accept(Visitor *v)
 }
 char *IntNode::type()
 {
-    return (char*)"Int";
+    return NAME_INT;
 }
 
 NotNode::NotNode(RExpr *v) : value(v) {}
@@ -243,7 +288,7 @@ void NotNode::accept(Visitor *v)
 }
 char *NotNode::type()
 {
-    return (char*)"Boolean";
+    return NAME_BOOLEAN;
 }
 
 BinaryOperatorNode::BinaryOperatorNode(RExpr *l, RExpr *r, int o)
@@ -252,18 +297,14 @@ BinaryOperatorNode::BinaryOperatorNode(RExpr *l, RExpr *r, int o)
     left  = l;
     operation = o;  //plus:0 minus:1 times:2 divide:3 equals:4 atmost:5 lessthan:6 atleast:7 greater:8 and:9 or:10
 }
-BinaryOperatorNode::~BinaryOperatorNode() 
-{
-    delete left;
-    delete right;
-}
+BinaryOperatorNode::~BinaryOperatorNode() {}
 void BinaryOperatorNode::accept(Visitor *v)
 {
     v->visitBinaryOperatorNode(this);
 }
 char *BinaryOperatorNode::type()
 {
-    return (char*)"-";  //the default
+    return NAME_UNKNOWN;  //the default
 }
 
 
@@ -298,7 +339,7 @@ void EqualsNode::print()
 }
 char* EqualsNode::type()
 {
-    return (char*)"Boolean";
+    return NAME_BOOLEAN;
 }
 
 AtMostNode::AtMostNode(RExpr *l, RExpr *r) : BinaryOperatorNode(l, r, 5) {}
@@ -308,7 +349,7 @@ void AtMostNode::print()
 }
 char* AtMostNode::type()
 {
-    return (char*)"Boolean";
+    return NAME_BOOLEAN;
 }
 
 LessThanNode::LessThanNode(RExpr *l, RExpr *r) : BinaryOperatorNode(l, r, 6) {}
@@ -318,7 +359,7 @@ void LessThanNode::print()
 }
 char* LessThanNode::type()
 {
-    return (char*)"Boolean";
+    return NAME_BOOLEAN;
 }
 
 AtLeastNode::AtLeastNode(RExpr *l, RExpr *r) : BinaryOperatorNode(l, r, 7) {}
@@ -328,7 +369,7 @@ void AtLeastNode::print()
 }
 char* AtLeastNode::type()
 {
-    return (char*)"Boolean";
+    return NAME_BOOLEAN;
 }
 
 GreaterThanNode::GreaterThanNode(RExpr *l, RExpr *r) : BinaryOperatorNode(l, r, 8) {}
@@ -338,7 +379,7 @@ void GreaterThanNode::print()
 }
 char* GreaterThanNode::type()
 {
-    return (char*)"Boolean";
+    return NAME_BOOLEAN;
 }
 
 AndNode::AndNode(RExpr *l, RExpr *r) : BinaryOperatorNode(l, r, 9) {}
@@ -348,7 +389,7 @@ void AndNode::print()
 }
 char* AndNode::type()
 {
-    return (char*)"Boolean";
+    return NAME_BOOLEAN;
 }
 
 OrNode::OrNode(RExpr *l, RExpr *r) : BinaryOperatorNode(l, r, 10) {}
@@ -358,7 +399,7 @@ void OrNode::print()
 }
 char* OrNode::type()
 {
-    return (char*)"Boolean";
+    return NAME_BOOLEAN;
 }
 
 
@@ -369,10 +410,7 @@ char* OrNode::type()
 Statement::~Statement() {}
 
 RExprStatement::RExprStatement(RExpr *r) : rexpr(r) {}
-RExprStatement::~RExprStatement()
-{
-    delete rexpr;
-}
+RExprStatement::~RExprStatement() {}
 void RExprStatement::print()
 {
     fprintf(stdout, "Found RExprStatement\n");
@@ -383,10 +421,7 @@ void RExprStatement::accept(Visitor *v)
 }
 
 ReturnStatement::ReturnStatement(RExpr *r) : rexpr(r) {}
-ReturnStatement::~ReturnStatement() 
-{
-    delete rexpr;
-}
+ReturnStatement::~ReturnStatement() {}
 void ReturnStatement::print()
 {
     fprintf(stdout, "Found ReturnStatement\n");
@@ -398,12 +433,7 @@ void ReturnStatement::accept(Visitor *v)
 
 AssignmentStatement::AssignmentStatement(LExpr *l, IdentOption *i, RExpr *r) 
     : lexpr(l), ident(i), rexpr(r) {}
-AssignmentStatement::~AssignmentStatement()
-{
-    delete lexpr;
-    delete ident;
-    delete rexpr;
-}
+AssignmentStatement::~AssignmentStatement() {}
 void AssignmentStatement::print()
 {
     fprintf(stdout, "Found AssignmentStatement\n");
@@ -413,16 +443,8 @@ void AssignmentStatement::accept(Visitor *v)
     v->visitAssignmentStatement(this);
 }
 
-WhileStatement::WhileStatement(RExpr *r, list<Statement *> *s) : rexpr(r), stmts(s) {}
-WhileStatement::~WhileStatement()
-{
-    delete rexpr;
-    for (list<Statement *>::const_iterator it = stmts->begin(); it != stmts->end(); ++it)
-    {
-        delete (*it);
-    }
-    delete stmts;
-}
+WhileStatement::WhileStatement(RExpr *r, NodeList<Statement *> *s) : rexpr(r), stmts(s) {}
+WhileStatement::~WhileStatement() {}
 void WhileStatement::print()
 {
     fprintf(stdout, "Found a WhileStatement\n");
@@ -432,7 +454,7 @@ void WhileStatement::accept(Visitor *v)
     v->visitWhileStatement(this);
 }
 
-IfClause::IfClause(RExpr *r, list<Statement *> *s) : rexpr(r), stmts(s) {}
+IfClause::IfClause(RExpr *r, NodeList<Statement *> *s) : rexpr(r), stmts(s) {}
 void IfClause::print()
 {
     fprintf(stdout, "Found IfClause\n");
@@ -442,7 +464,7 @@ void IfClause::accept(Visitor *v)
     v->visitIfClause(this);
 }
 
-ElifClause::ElifClause(RExpr *r, list<Statement *> *s) : rexpr(r), stmts(s) {}
+ElifClause::ElifClause(RExpr *r, NodeList<Statement *> *s) : rexpr(r), stmts(s) {}
 void ElifClause::print()
 {
     fprintf(stdout, "Found ElifClause\n");
@@ -462,7 +484,7 @@ void FalseElseOption::accept(Visitor *v)
     v->visitFalseElseOption(this);
 }
 
-TrueElseOption::TrueElseOption(list<Statement *> *s) : stmts(s) {}
+TrueElseOption::TrueElseOption(NodeList<Statement *> *s) : stmts(s) {}
 void TrueElseOption::print()
 {
     fprintf(stdout, "Found TrueElseOption\n");
@@ -472,7 +494,7 @@ void TrueElseOption::accept(Visitor *v)
     v->visitTrueElseOption(this);
 }
 
-IfBlock::IfBlock(IfClause *i, list<ElifClause *> *ei, ElseOption *el) 
+IfBlock::IfBlock(IfClause *i, NodeList<ElifClause *> *ei, ElseOption *el) 
     : _if(i), _elifs(ei), _else(el) {}
 void IfBlock::print()
 {
@@ -487,10 +509,7 @@ LExpr::~LExpr() {}
 void LExpr::print(FILE *f) {}
 
 IdentNode::IdentNode(char *i) : id(i) {}
-IdentNode::~IdentNode()
-{
-    free(id);
-}
+IdentNode::~IdentNode() {}
 void IdentNode::print()
 {
     fprintf(stdout, "Found a LExpr\n");
@@ -515,21 +534,9 @@ void ObjectFieldLExpr::accept(Visitor *v)
 }
 
 
-Program::Program(list<Class *> *c, list<Statement *> *s, int l) 
-    : classes(c), statements(s), Node(l) {}
-Program::~Program()
-{
-    for (list<Class *>::const_iterator it = classes->begin(); it != classes->end(); ++it) 
-    {
-        delete (*it);
-    }
-    delete classes;
-    for (list<Statement *>::const_iterator it = statements->begin(); it != statements->end(); ++it) 
-    {
-        delete (*it);
-    }
-    delete statements;
-}
+Program::Program(NodeList<Class *> *c, NodeList<Statement *> *s, int l) 
+    : Node(l), statements(s), classes(c) {}
+Program::~Program() {} // the children are freed with astArena
 void Program::accept(Visitor *v)
 {
     v->visitProgram(this);
@@ -541,13 +548,13 @@ void Program::accept(Visitor *v)
 bool Program::checkClassHierarchy()
 {
     list<char *> def;     // defined by Quack
-    def.push_back((char *)"Obj");
-    def.push_back((char *)"Int");
-    def.push_back((char *)"String");
-    def.push_back((char *)"Nothing");
+    def.push_back(NAME_OBJ);
+    def.push_back(NAME_INT);
+    def.push_back(NAME_STRING);
+    def.push_back(NAME_NOTHING);
     list<char *> userDef; // defined by user
     list<char *> toBeDef; // to be defined by user
-    for (list<Class *>::const_iterator it = classes->begin(); it != classes->end(); ++it)
+    for (NodeList<Class *>::const_iterator it = classes->begin(); it != classes->end(); ++it)
     {
         char *id = (*it)->getID();
         char *extend = (*it)->getExtends();
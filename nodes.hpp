@@ -12,6 +12,7 @@
 #include <list>
 
 #include <stdio.h>
+#include <string.h>
 
 #include "SymbolTable.hpp"
 
@@ -19,6 +20,84 @@ using std::list;
 
 class Visitor; 
 
+/* The memory the AST lives in. Nodes and their child lists are carved
+ * out of large blocks one after the other, and release() frees every
+ * block at once: the tree is never taken apart node by node
+ * */
+class Arena
+{
+    public:
+        void *allocate(size_t size);
+        void release();
+    private:
+        struct Block
+        {
+            Block *next;
+        };
+        Block *blocks; // the one being filled first
+        char *unused;  // where the free part of the first block starts
+        size_t left;
+};
+
+extern Arena astArena;
+
+/* The children of a node, stored contiguously in the arena. The first
+ * few are kept inside the NodeList itself; a longer list moves to an
+ * array twice the size whenever it fills up
+ * */
+template <class T>
+class NodeList
+{
+    public:
+        typedef T *iterator;
+        typedef const T *const_iterator;
+
+        NodeList() : items(small), count(0), capacity(smallSize) {}
+        NodeList(const NodeList &) = delete;
+        NodeList &operator=(const NodeList &) = delete;
+
+        void *operator new(size_t size) { return astArena.allocate(size); }
+        void operator delete(void *) {}
+
+        iterator begin() { return items; }
+        iterator end() { return items + count; }
+        const_iterator begin() const { return items; }
+        const_iterator end() const { return items + count; }
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+        T &front() { return items[0]; }
+        T &back() { return items[count - 1]; }
+
+        void push_back(T item)
+        {
+            if (count == capacity)
+                grow();
+            items[count++] = item;
+        }
+        // Remove the child at 'it', returning where the next one now is
+        iterator erase(iterator it)
+        {
+            memmove(it, it + 1, (end() - it - 1) * sizeof(T));
+            count--;
+            return it;
+        }
+
+    private:
+        static const size_t smallSize = 4;
+        T *items;
+        size_t count;
+        size_t capacity;
+        T small[smallSize];
+
+        void grow()
+        {
+            T *bigger = (T *) astArena.allocate(2 * capacity * sizeof(T));
+            memcpy(bigger, items, count * sizeof(T));
+            items = bigger;
+            capacity *= 2;
+        }
+};
+
 /* ********
  *
  * Listed below are the classes defined in this file
@@ -87,6 +166,7 @@ class Program;
 
 
 // The base class which all AST-nodes are derived
+// Nodes are allocated in astArena, and deleting one does nothing
 class Node 
 {
     public:
@@ -96,6 +176,9 @@ class Node
         Node(int l);
         Node() {lineno = 0;}
         void setLineno(int l);
+
+        void *operator new(size_t size) { return astArena.allocate(size); }
+        void operator delete(void *) {}
 };
 
 class Class : public Node 
@@ -158,10 +241,10 @@ class ClassSignature : public Node
 {
     public:
         char *id;
-        list<FormalArg *> *fargs;
+        NodeList<FormalArg *> *fargs;
         ExtendsOption *exop;
 
-        ClassSignature(char *i, list<FormalArg *> *f, ExtendsOption *e);
+        ClassSignature(char *i, NodeList<FormalArg *> *f, ExtendsOption *e);
         virtual void print();
         virtual void accept(Visitor *v);
         char *getID();
@@ -171,10 +254,10 @@ class ClassSignature : public Node
 class ClassBody : public Node 
 {
     public:
-        list<Statement *> *stmts;
-        list<Method *> *meths;
+        NodeList<Statement *> *stmts;
+        NodeList<Method *> *meths;
 
-        ClassBody(list<Statement *> *s, list<Method *> *m);
+        ClassBody(NodeList<Statement *> *s, NodeList<Method *> *m);
         virtual void print();
         virtual void accept(Visitor *v);
 };
@@ -212,11 +295,11 @@ class Method : public Node
 {
     public:
         char *id;
-        list<FormalArg *> *fargs;
+        NodeList<FormalArg *> *fargs;
         IdentOption *ident;
-        list<Statement *> *stmts;
+        NodeList<Statement *> *stmts;
 
-        Method(char *, list<FormalArg *> *, IdentOption *, list<Statement *> *);
+        Method(char *, NodeList<FormalArg *> *, IdentOption *, NodeList<Statement *> *);
         virtual void print(); 
         virtual void accept(Visitor *v);
 };
@@ -229,6 +312,15 @@ class Method : public Node
 class RExpr : public Node  //ABC
 {
     public:
+        // The static type of the expression. The type checker keeps the
+        // type it worked out with the scope and version of the tables
+        // it used; once checking succeeds it holds the final type, which
+        // every later pass reads
+        char *resolvedType;
+        SymbolTable *resolvedIn;
+        unsigned long resolvedAt;
+
+        RExpr();
         virtual ~RExpr();
 
         virtual void print() = 0;
@@ -250,9 +342,9 @@ class DotRExpr : public RExpr
     public:
         RExpr         *rexpr;
         char          *id;
-        list<RExpr *> *args;
+        NodeList<RExpr *> *args;
 
-        DotRExpr(RExpr *r, char *i, list<RExpr *> *a);
+        DotRExpr(RExpr *r, char *i, NodeList<RExpr *> *a);
         virtual void print();
         virtual void accept(Visitor *v);
 };
@@ -261,9 +353,10 @@ class ConstructorRExpr : public RExpr
 {
     public:
         char *id;
-        list<RExpr *> *args;
+        NodeList<RExpr *> *args;
+        bool onStack; // the object never outlives the body (EscapeVisitor)
 
-        ConstructorRExpr(char *i, list<RExpr *> *a);
+        ConstructorRExpr(char *i, NodeList<RExpr *> *a);
         virtual void print();
         virtual void accept(Visitor *v);
         virtual char *type();
@@ -480,9 +573,9 @@ class WhileStatement : public Statement
 {
     public:
         RExpr *rexpr;
-        list<Statement *> *stmts;
+        NodeList<Statement *> *stmts;
 
-        WhileStatement(RExpr *r, list<Statement *> *s);
+        WhileStatement(RExpr *r, NodeList<Statement *> *s);
         virtual ~WhileStatement();
 
         virtual void print();
@@ -494,10 +587,10 @@ class IfBlock : public Statement
 {
     public:
         IfClause *_if;
-        list<ElifClause *> *_elifs;
+        NodeList<ElifClause *> *_elifs;
         ElseOption *_else;
 
-        IfBlock(IfClause *i, list<ElifClause *> *ei, ElseOption *el);
+        IfBlock(IfClause *i, NodeList<ElifClause *> *ei, ElseOption *el);
         virtual void print();
         virtual void accept(Visitor *v);
 };
@@ -506,9 +599,9 @@ class IfClause : public Node
 {
     public:
         RExpr *rexpr;
-        list<Statement *> *stmts;
+        NodeList<Statement *> *stmts;
 
-        IfClause(RExpr *r, list<Statement *> *stmts);
+        IfClause(RExpr *r, NodeList<Statement *> *stmts);
         virtual void print();
         virtual void accept(Visitor *v);
 };
@@ -517,9 +610,9 @@ class ElifClause : public Node
 {
     public:
         RExpr *rexpr;
-        list<Statement *> *stmts;
+        NodeList<Statement *> *stmts;
 
-        ElifClause(RExpr *r, list<Statement *> *stmts);
+        ElifClause(RExpr *r, NodeList<Statement *> *stmts);
         virtual void print();
         virtual void accept(Visitor *v);
 };
@@ -542,9 +635,9 @@ class FalseElseOption : public ElseOption
 class TrueElseOption : public ElseOption
 {
     public:
-        list<Statement *> *stmts;
+        NodeList<Statement *> *stmts;
 
-        TrueElseOption(list<Statement *> *s);
+        TrueElseOption(NodeList<Statement *> *s);
         virtual void print();
         virtual void accept(Visitor *v);
 };
@@ -591,10 +684,10 @@ class ObjectFieldLExpr : public LExpr
 class Program : public Node 
 {
     public:
-        list<Statement *> *statements;
-        list<Class *>     *classes;
+        NodeList<Statement *> *statements;
+        NodeList<Class *>     *classes;
 
-        Program(list<Class *> *c, list<Statement *> *s, int);
+        Program(NodeList<Class *> *c, NodeList<Statement *> *s, int);
         virtual ~Program();
 
         bool checkClassHierarchy();
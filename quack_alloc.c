@@ -0,0 +1,208 @@
+/*
+ * Implementation of the Quack runtime allocator
+ *
+ * Chunks are requested from malloc and handed out front to back.
+ * The chunk table is kept sorted by address so the collector can ask
+ * whether a pointer belongs to the heap with a binary search.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "quack_alloc.h"
+
+char *quack_bump  = NULL;
+char *quack_limit = NULL;
+void *quack_free[QUACK_SMALL_MAX / QUACK_ALIGN + 1];
+size_t quack_alloc_count = 0;
+size_t quack_alloc_bytes = 0;
+
+struct chunk {
+    char *start;
+    char *used;     /* end of the last block handed out */
+    char *limit;
+    int big;        /* holds a single block bigger than QUACK_SMALL_MAX */
+};
+
+static struct chunk *chunks = NULL;
+static size_t chunk_count = 0;
+static size_t chunk_capacity = 0;
+static char *current = NULL;    /* start of the chunk quack_bump points into */
+static char *heap_low = NULL;
+static char *heap_high = NULL;
+
+static size_t chunk_size = 0;
+static size_t freed_count = 0;
+
+static void print_stats(void)
+{
+    fprintf(stderr, "quack_alloc: %zu objects, %zu bytes, %zu chunks of %zu bytes\n",
+            quack_alloc_count, quack_alloc_bytes, chunk_count, chunk_size);
+    fprintf(stderr, "quack_alloc: %zu blocks freed\n", freed_count);
+}
+
+/* Read the configuration the first time a chunk is needed */
+static void configure(void)
+{
+    char *env = getenv("QUACK_CHUNK_SIZE");
+    if (chunk_size == 0) {
+        chunk_size = QUACK_CHUNK_SIZE;
+        if (env != NULL && atol(env) > 0) {
+            chunk_size = (size_t) atol(env);
+        }
+    }
+    if (chunk_size < 4 * QUACK_SMALL_MAX) {
+        chunk_size = 4 * QUACK_SMALL_MAX;
+    }
+    if (getenv("QUACK_STATS") != NULL) {
+        atexit(print_stats);
+    }
+    quack_gc_init();
+}
+
+void quack_alloc_set_chunk_size(size_t size)
+{
+    chunk_size = size;
+}
+
+/* Find the chunk holding 'p', or NULL */
+static struct chunk *find_chunk(void *p)
+{
+    size_t lo = 0, hi = chunk_count;
+    char *c = (char *) p;
+    if (c < heap_low || c >= heap_high) {
+        return NULL;
+    }
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (c < chunks[mid].start) {
+            hi = mid;
+        } else if (c >= chunks[mid].limit) {
+            lo = mid + 1;
+        } else {
+            return &chunks[mid];
+        }
+    }
+    return NULL;
+}
+
+int quack_alloc_contains(void *p)
+{
+    return find_chunk(p) != NULL;
+}
+
+/* Get 'size' bytes from malloc and add them to the chunk table */
+static char *new_chunk(size_t size, int big)
+{
+    size_t i;
+    char *start = malloc(size);
+    if (start == NULL) {
+        fprintf(stderr, "quack_alloc: out of memory\n");
+        exit(1);
+    }
+    if (chunk_count == chunk_capacity) {
+        chunk_capacity = chunk_capacity == 0 ? 64 : chunk_capacity * 2;
+        chunks = realloc(chunks, chunk_capacity * sizeof(struct chunk));
+        if (chunks == NULL) {
+            fprintf(stderr, "quack_alloc: out of memory\n");
+            exit(1);
+        }
+    }
+    i = chunk_count++;
+    while (i > 0 && chunks[i - 1].start > start) {
+        chunks[i] = chunks[i - 1];
+        i--;
+    }
+    chunks[i].start = start;
+    chunks[i].used  = start;
+    chunks[i].limit = start + size;
+    chunks[i].big   = big;
+    if (heap_low == NULL || start < heap_low) {
+        heap_low = start;
+    }
+    if (start + size > heap_high) {
+        heap_high = start + size;
+    }
+    return start;
+}
+
+/* Record how far the current chunk has been used */
+static void retire_current(void)
+{
+    struct chunk *c;
+    if (current != NULL) {
+        c = find_chunk(current);
+        c->used = quack_bump;
+    }
+}
+
+void *quack_alloc_slow(size_t size, size_t flags)
+{
+    char *block;
+    if (chunk_size == 0) {
+        configure();
+    }
+    if (quack_alloc_bytes + size > quack_gc_next) {
+        quack_gc_collect();
+        if (size <= QUACK_SMALL_MAX) {
+            return quack_alloc_block(size, flags);
+        }
+    }
+
+    if (size > QUACK_SMALL_MAX) {
+        /* Big object: give it its own chunk, keep bumping in the current one */
+        block = new_chunk(size + sizeof(size_t), 1);
+        find_chunk(block)->used = block + size + sizeof(size_t);
+        block += sizeof(size_t);
+    } else {
+        retire_current();
+        current = new_chunk(chunk_size, 0);
+        quack_bump  = current;
+        quack_limit = current + chunk_size;
+        block = quack_bump + sizeof(size_t);
+        quack_bump = block + size;
+    }
+    quack_alloc_count++;
+    quack_alloc_bytes += size;
+    quack_header(block) = size | flags;
+    memset(block, 0, size);
+    quack_gc_keep(block);
+    return block;
+}
+
+size_t quack_alloc_sweep(void)
+{
+    size_t i, j, live = 0;
+    retire_current();
+    for (i = 0; i <= QUACK_SMALL_MAX / QUACK_ALIGN; i++) {
+        quack_free[i] = NULL;
+    }
+    for (i = 0, j = 0; i < chunk_count; i++) {
+        struct chunk c = chunks[i];
+        char *p = c.start;
+        if (c.big && !(*(size_t *) p & QUACK_MARKED)) {
+            freed_count++;
+            free(c.start);
+            continue;
+        }
+        while (p < c.used) {
+            size_t *header = (size_t *) p;
+            size_t size = *header & ~(size_t) QUACK_FLAGS;
+            void *block = p + sizeof(size_t);
+            if (*header & QUACK_MARKED) {
+                *header &= ~(size_t) QUACK_MARKED;
+                live += size;
+            } else {
+                if (!(*header & QUACK_FREE)) {
+                    freed_count++;
+                }
+                *header = size | QUACK_FREE;
+                *(void **) block = quack_free[size / QUACK_ALIGN];
+                quack_free[size / QUACK_ALIGN] = block;
+            }
+            p += sizeof(size_t) + size;
+        }
+        chunks[j++] = c;
+    }
+    chunk_count = j;
+    return live;
+}
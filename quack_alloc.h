@@ -0,0 +1,107 @@
+/*
+ * quack_alloc: the allocator used for every Quack runtime object
+ *
+ * Objects are carved out of large chunks with a bump pointer instead
+ * of calling malloc once per object. The allocator keeps no per-thread
+ * state and takes no locks; the compiled program is single threaded.
+ *
+ * Every block is preceded by a one word header holding its size and
+ * the collector's flags. Blocks freed by the collector (quack_gc.h) go
+ * on free lists, one per size, and are reused before bumping. Blocks
+ * bigger than QUACK_SMALL_MAX get a malloc'd chunk of their own.
+ *
+ * The chunk size can be set when building the runtime
+ * (-DQUACK_CHUNK_SIZE=bytes), or when running a compiled program
+ * with the QUACK_CHUNK_SIZE environment variable.
+ *
+ * Setting the QUACK_STATS environment variable prints allocation
+ * and collection counts to stderr when the program exits.
+ */
+
+#ifndef quack_alloc_h
+#define quack_alloc_h
+
+#include <stddef.h>
+#include <string.h>
+
+#include "quack_gc.h"
+
+#ifndef QUACK_CHUNK_SIZE
+#define QUACK_CHUNK_SIZE (1024 * 1024)
+#endif
+
+/* Every block is aligned to this many bytes */
+#define QUACK_ALIGN 8
+
+/* Biggest block allocated from a shared chunk */
+#define QUACK_SMALL_MAX 2048
+
+/* Header flags, kept in the low bits of the size */
+#define QUACK_MARKED 1
+#define QUACK_FREE   2
+#define QUACK_RAW    4    /* block holds no pointers (text) */
+#define QUACK_FLAGS  7
+
+#define quack_header(p) (((size_t *) (p))[-1])
+
+/* Current chunk and free lists; only quack_alloc and quack_alloc.c touch these */
+extern char *quack_bump;
+extern char *quack_limit;
+extern void *quack_free[QUACK_SMALL_MAX / QUACK_ALIGN + 1];
+extern size_t quack_alloc_count;
+extern size_t quack_alloc_bytes;
+
+/* Slow path: collect if needed, then start a new chunk */
+extern void *quack_alloc_slow(size_t size, size_t flags);
+
+/* Change the size of chunks allocated from now on */
+extern void quack_alloc_set_chunk_size(size_t size);
+
+/* Is 'p' a block handed out by quack_alloc? */
+extern int quack_alloc_contains(void *p);
+
+/* Free every block that is not marked, unmark the rest.
+ * Returns the number of bytes still in use */
+extern size_t quack_alloc_sweep(void);
+
+/* Allocate a zeroed block of 'size' bytes; never returns NULL */
+static inline void *quack_alloc_block(size_t size, size_t flags)
+{
+    char *p;
+    size = (size + QUACK_ALIGN - 1) & ~(size_t)(QUACK_ALIGN - 1);
+    if (size == 0) {
+        size = QUACK_ALIGN;     /* room for the free list link */
+    }
+    if (size > QUACK_SMALL_MAX || quack_alloc_bytes + size > quack_gc_next) {
+        return quack_alloc_slow(size, flags);
+    }
+    p = quack_free[size / QUACK_ALIGN];
+    if (p != NULL) {
+        quack_free[size / QUACK_ALIGN] = *(void **) p;
+    } else if ((size_t)(quack_limit - quack_bump) >= size + sizeof(size_t)) {
+        p = quack_bump + sizeof(size_t);
+        quack_bump = p + size;
+    } else {
+        return quack_alloc_slow(size, flags);
+    }
+    quack_alloc_count++;
+    quack_alloc_bytes += size;
+    quack_header(p) = size | flags;
+    memset(p, 0, size);
+    quack_gc_keep(p);
+    return p;
+}
+
+/* Allocate an object, traced through its class's gc_map */
+static inline void *quack_alloc(size_t size)
+{
+    return quack_alloc_block(size, 0);
+}
+
+/* Allocate a block the collector does not look inside */
+static inline void *quack_alloc_raw(size_t size)
+{
+    return quack_alloc_block(size, QUACK_RAW);
+}
+
+#endif
@@ -0,0 +1,141 @@
+/*
+ * Implementation of the Quack garbage collector
+ *
+ * Marking walks the shadow stack and the temporary stack, then traces
+ * objects through the gc_map of their class with an explicit mark
+ * stack, so long chains of objects do not overflow the C stack.
+ * Sweeping is left to quack_alloc, which owns the chunks.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Builtins.h"
+#include "quack_alloc.h"
+#include "quack_gc.h"
+
+struct quack_frame *quack_frames = NULL;
+void **quack_temps = NULL;
+void **quack_temps_top = NULL;
+void **quack_temps_end = NULL;
+size_t quack_gc_next = 0;
+
+static size_t threshold = QUACK_GC_THRESHOLD;
+static size_t collections = 0;
+
+static void **mark_stack = NULL;
+static size_t mark_top = 0;
+static size_t mark_capacity = 0;
+
+static void print_stats(void)
+{
+    fprintf(stderr, "quack_gc: %zu collections, threshold %zu bytes\n", collections, threshold);
+}
+
+void quack_gc_init(void)
+{
+    char *env = getenv("QUACK_GC_THRESHOLD");
+    if (env != NULL && atol(env) > 0) {
+        threshold = (size_t) atol(env);
+    }
+    if (threshold < 4 * QUACK_SMALL_MAX) {
+        threshold = 4 * QUACK_SMALL_MAX;
+    }
+    quack_gc_next = quack_alloc_bytes + threshold;
+    if (getenv("QUACK_STATS") != NULL) {
+        atexit(print_stats);
+    }
+}
+
+void quack_gc_grow_temps(void)
+{
+    size_t count = quack_temps_top - quack_temps;
+    size_t capacity = count == 0 ? 1024 : count * 2;
+    struct quack_frame *frame;
+    void **temps = realloc(quack_temps, capacity * sizeof(void *));
+    if (temps == NULL) {
+        fprintf(stderr, "quack_gc: out of memory\n");
+        exit(1);
+    }
+    /* Frames remember temporary stack heights; move them along */
+    for (frame = quack_frames; frame != NULL; frame = frame->prev) {
+        frame->temps = temps + (frame->temps - quack_temps);
+    }
+    quack_temps = temps;
+    quack_temps_top = temps + count;
+    quack_temps_end = temps + capacity;
+}
+
+static void push(void *p)
+{
+    if (mark_top == mark_capacity) {
+        mark_capacity = mark_capacity == 0 ? 1024 : mark_capacity * 2;
+        mark_stack = realloc(mark_stack, mark_capacity * sizeof(void *));
+        if (mark_stack == NULL) {
+            fprintf(stderr, "quack_gc: out of memory\n");
+            exit(1);
+        }
+    }
+    mark_stack[mark_top++] = p;
+}
+
+/* Mark 'p' and queue it for tracing. Objects outside the heap
+ * (literals, lit_true, nothing) carry no mark but are still traced */
+static void mark(void *p)
+{
+    if (p == NULL) {
+        return;
+    }
+    if (quack_alloc_contains(p)) {
+        if (quack_header(p) & (QUACK_MARKED | QUACK_FREE)) {
+            return;
+        }
+        quack_header(p) |= QUACK_MARKED;
+        if (quack_header(p) & QUACK_RAW) {
+            return;
+        }
+    }
+    push(p);
+}
+
+static void trace(void)
+{
+    while (mark_top > 0) {
+        obj_Obj obj = (obj_Obj) mark_stack[--mark_top];
+        const size_t *map = obj->clazz->gc_map;
+        if (map == NULL) {
+            continue;
+        }
+        for (; *map != 0; map++) {
+            void *field = *(void **) ((char *) obj + (*map & ~(size_t) 1));
+            if (*map & 1) {
+                if (field != NULL && quack_alloc_contains(field)) {
+                    quack_header(field) |= QUACK_MARKED;
+                }
+            } else {
+                mark(field);
+            }
+        }
+    }
+}
+
+void quack_gc_collect(void)
+{
+    struct quack_frame *frame;
+    void **temp;
+    size_t live;
+    int i;
+
+    collections++;
+    for (frame = quack_frames; frame != NULL; frame = frame->prev) {
+        for (i = 0; i < frame->count; i++) {
+            mark(*(void **) frame->roots[i]);
+        }
+    }
+    for (temp = quack_temps; temp < quack_temps_top; temp++) {
+        mark(*temp);
+    }
+    trace();
+
+    live = quack_alloc_sweep();
+    quack_gc_next = quack_alloc_bytes + (live > threshold ? live : threshold);
+}
@@ -0,0 +1,109 @@
+/*
+ * quack_gc: precise mark-sweep garbage collector for the Quack runtime
+ *
+ * The collector finds live objects from three kinds of roots:
+ *   - the shadow stack. Every compiled method (and main) pushes a
+ *     quack_frame listing the addresses of its object-typed locals
+ *   - the temporary stack. Every new block is kept here until the
+ *     statement that allocated it is finished (quack_safepoint), so
+ *     values in the middle of an expression survive a collection
+ *   - return values. quack_return pops a frame and hands the returned
+ *     object to the caller's temporary stack
+ *
+ * Objects are traced through the gc_map of their class: the offsets of
+ * the pointer fields of the object, ended by 0. Fields that hold raw
+ * (unscanned) blocks use QUACK_RAW_FIELD.
+ *
+ * A collection starts when the bytes allocated since the last one
+ * cross the threshold. The threshold is set with -DQUACK_GC_THRESHOLD
+ * when building the runtime, or with the QUACK_GC_THRESHOLD environment
+ * variable, and grows with the amount of live data.
+ */
+
+#ifndef quack_gc_h
+#define quack_gc_h
+
+#include <stddef.h>
+
+#ifndef QUACK_GC_THRESHOLD
+#define QUACK_GC_THRESHOLD (4 * 1024 * 1024)
+#endif
+
+/* Pointer map entry for a field holding a raw block */
+#define QUACK_RAW_FIELD(offset) ((offset) | 1)
+
+/* One activation record on the shadow stack */
+struct quack_frame {
+    struct quack_frame *prev;
+    void **roots;       /* addresses of the object-typed locals */
+    int count;
+    void **temps;       /* height of the temporary stack on entry */
+};
+
+extern struct quack_frame *quack_frames;
+extern void **quack_temps;
+extern void **quack_temps_top;
+extern void **quack_temps_end;
+extern size_t quack_gc_next;   /* quack_alloc_bytes that triggers the next collection */
+
+extern void quack_gc_init(void);
+extern void quack_gc_collect(void);
+extern void quack_gc_grow_temps(void);
+
+/* Keep 'p' alive until the current statement is finished */
+static inline void quack_gc_keep(void *p)
+{
+    if (quack_temps_top == quack_temps_end) {
+        quack_gc_grow_temps();
+    }
+    *quack_temps_top++ = p;
+}
+
+/* Push a frame whose roots are the 'count' locals listed in 'roots' */
+static inline void quack_enter(struct quack_frame *frame, void **roots, int count)
+{
+    frame->prev  = quack_frames;
+    frame->roots = roots;
+    frame->count = count;
+    frame->temps = quack_temps_top;
+    quack_frames = frame;
+}
+
+/* Pop a frame pushed for a nested block */
+static inline void quack_leave(struct quack_frame *frame)
+{
+    quack_frames = frame->prev;
+}
+
+/* End of a statement: temporaries of the current method are dead */
+static inline void quack_safepoint(struct quack_frame *frame)
+{
+    quack_temps_top = frame->temps;
+}
+
+/* Pop the method's frame (and any nested ones), keep the result alive */
+static inline void *quack_return(struct quack_frame *frame, void *result)
+{
+    quack_frames = frame->prev;
+    quack_temps_top = frame->temps;
+    quack_gc_keep(result);
+    return result;
+}
+
+/* Pop the nested frames and the temporaries of the method whose frame is
+ * 'frame', before it jumps back to its start for a tail call to itself */
+static inline void quack_restart(struct quack_frame *frame)
+{
+    quack_frames = frame;
+    quack_temps_top = frame->temps;
+}
+
+/* Pop the method's frame when the result is an unboxed Int or Boolean */
+static inline long quack_return_value(struct quack_frame *frame, long result)
+{
+    quack_frames = frame->prev;
+    quack_temps_top = frame->temps;
+    return result;
+}
+
+#endif
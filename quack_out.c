@@ -0,0 +1,59 @@
+/*
+ * Implementation of the Quack output buffer
+ *
+ * The buffer starts out looking full, so the first write takes the
+ * slow path, which empties it and registers an exit handler. Nothing
+ * is left in the buffer when main returns or the runtime calls exit.
+ */
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "quack_out.h"
+
+char quack_out_buf[QUACK_OUT_SIZE];
+size_t quack_out_len = QUACK_OUT_SIZE;
+
+static int registered = 0;
+
+/* write(2) all of 's', retrying short writes */
+static void write_all(const char *s, size_t n)
+{
+    while (n > 0) {
+        ssize_t done = write(1, s, n);
+        if (done < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            perror("quack_out");
+            _exit(1);
+        }
+        s += done;
+        n -= (size_t) done;
+    }
+}
+
+void quack_out_flush(void)
+{
+    write_all(quack_out_buf, quack_out_len);
+    quack_out_len = 0;
+}
+
+void quack_out_slow(const char *s, size_t n)
+{
+    if (!registered) {
+        registered = 1;
+        quack_out_len = 0;
+        atexit(quack_out_flush);
+    }
+    if (n > QUACK_OUT_SIZE - quack_out_len) {
+        quack_out_flush();
+    }
+    if (n > QUACK_OUT_SIZE) {
+        write_all(s, n);
+        return;
+    }
+    memcpy(quack_out_buf + quack_out_len, s, n);
+    quack_out_len += n;
+}
@@ -0,0 +1,75 @@
+/*
+ * quack_out: buffered standard output for the Quack runtime
+ *
+ * PRINT methods append to one large buffer instead of going through
+ * stdio. The buffer is handed to write(2) when it fills up and when
+ * the program exits, so a program printing many small values makes
+ * few system calls. Output still buffered when the program crashes
+ * is lost.
+ *
+ * The buffer size can be set when building the runtime
+ * (-DQUACK_OUT_SIZE=bytes).
+ */
+
+#ifndef quack_out_h
+#define quack_out_h
+
+#include <stddef.h>
+#include <string.h>
+
+#ifndef QUACK_OUT_SIZE
+#define QUACK_OUT_SIZE (64 * 1024)
+#endif
+
+extern char quack_out_buf[QUACK_OUT_SIZE];
+extern size_t quack_out_len;
+
+/* Write out everything buffered so far */
+extern void quack_out_flush(void);
+
+/* Slow path: make room, or write 'n' bytes straight out if they are too many */
+extern void quack_out_slow(const char *s, size_t n);
+
+/* Append 'n' bytes */
+static inline void quack_out_write(const char *s, size_t n)
+{
+    if (n > QUACK_OUT_SIZE - quack_out_len) {
+        quack_out_slow(s, n);
+        return;
+    }
+    memcpy(quack_out_buf + quack_out_len, s, n);
+    quack_out_len += n;
+}
+
+/* Append a C string */
+static inline void quack_out_str(const char *s)
+{
+    quack_out_write(s, strlen(s));
+}
+
+/* Write 'n' in decimal so that it ends just before 'end', which needs
+ * QUACK_INT_DIGITS bytes before it. Returns where the digits start */
+#define QUACK_INT_DIGITS 11
+static inline char *quack_format_int(int n, char *end)
+{
+    char *p = end;
+    unsigned int u = n < 0 ? 0u - (unsigned int) n : (unsigned int) n;
+    do {
+        *--p = (char) ('0' + u % 10);
+        u /= 10;
+    } while (u != 0);
+    if (n < 0) {
+        *--p = '-';
+    }
+    return p;
+}
+
+/* Append 'n' in decimal */
+static inline void quack_out_int(int n)
+{
+    char digits[QUACK_INT_DIGITS];
+    char *p = quack_format_int(n, digits + sizeof(digits));
+    quack_out_write(p, digits + sizeof(digits) - p);
+}
+
+#endif
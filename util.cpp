@@ -1,13 +1,17 @@
 #include <list>
+#include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 
+#include "util.hpp"
+
 using std::list;
 
 bool withinList(list<char *> *l, char *c)
 {
     for (list<char *>::const_iterator it = l->begin(); it != l->end(); ++it)
     {
-        if (strcmp(*it, c) == 0)
+        if (*it == c)
             return true;
     }
     return false;
@@ -18,10 +22,105 @@ int findWithinList(list<char *> *l, char *c)
     int i = 0;
     for (list<char *>::const_iterator it = l->begin(); it != l->end(); ++it)
     {
-        if (strcmp(*it, c) == 0)
+        if (*it == c)
             return i;
         i++;
     }
     return -1;
 }
 
+/* The interned names live in a hash table with open addressing, kept
+ * at most half full. Their text is copied into large blocks, one after
+ * the other, instead of being malloc'd one by one */
+static char **names = NULL;
+static size_t namesSize = 0;  // slots, a power of two
+static size_t namesCount = 0;
+
+#define NAME_BLOCK (64 * 1024)
+static char *block = NULL;
+static size_t blockLeft = 0;
+
+static uint32_t nameHash(const char *s, size_t len)
+{
+    uint32_t h = 2166136261u; // FNV-1a
+    for (size_t i = 0; i < len; i++)
+    {
+        h ^= (unsigned char) s[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static char *copyName(const char *s, size_t len)
+{
+    if (len + 1 > blockLeft)
+    {
+        size_t size = len + 1 > NAME_BLOCK ? len + 1 : NAME_BLOCK;
+        block = (char *) malloc(size);
+        blockLeft = size;
+    }
+    char *name = block;
+    memcpy(name, s, len);
+    name[len] = '\0';
+    block += len + 1;
+    blockLeft -= len + 1;
+    return name;
+}
+
+static void growNames()
+{
+    size_t oldSize = namesSize;
+    char **old = names;
+    namesSize = oldSize == 0 ? 1024 : oldSize * 2;
+    names = (char **) calloc(namesSize, sizeof(char *));
+    for (size_t i = 0; i < oldSize; i++)
+    {
+        if (old[i] == NULL)
+            continue;
+        size_t j = nameHash(old[i], strlen(old[i])) & (namesSize - 1);
+        while (names[j] != NULL)
+            j = (j + 1) & (namesSize - 1);
+        names[j] = old[i];
+    }
+    free(old);
+}
+
+char *intern(const char *s, size_t len)
+{
+    if (2 * (namesCount + 1) > namesSize)
+        growNames();
+    size_t i = nameHash(s, len) & (namesSize - 1);
+    while (names[i] != NULL)
+    {
+        if (strncmp(names[i], s, len) == 0 && names[i][len] == '\0')
+            return names[i];
+        i = (i + 1) & (namesSize - 1);
+    }
+    names[i] = copyName(s, len);
+    namesCount++;
+    return names[i];
+}
+
+char *intern(const char *s)
+{
+    return intern(s, strlen(s));
+}
+
+char *const NAME_OBJ     = intern("Obj");
+char *const NAME_INT     = intern("Int");
+char *const NAME_STRING  = intern("String");
+char *const NAME_BOOLEAN = intern("Boolean");
+char *const NAME_NOTHING = intern("Nothing");
+char *const NAME_THIS    = intern("this");
+char *const NAME_TRUE    = intern("true");
+char *const NAME_FALSE   = intern("false");
+char *const NAME_UNKNOWN = intern("-");
+
+char *operatorMethod(int operation)
+{
+    static char *const methods[] = {
+        intern("PLUS"), intern("MINUS"), intern("TIMES"), intern("DIVIDE"), intern("EQUALS"),
+        intern("ATMOST"), intern("LESS"), intern("ATLEAST"), intern("MORE"), intern("AND"), intern("OR")
+    };
+    return methods[operation];
+}
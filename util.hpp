@@ -7,13 +7,37 @@
 #define UTIL_H
 
 #include <list>
+#include <stddef.h>
 
 using std::list;
 
-/* Is 'c' within the list 'l'?  */
+/* Is 'c' within the list 'l'? Names are interned, so this compares pointers */
 bool withinList(list<char *> *l, char *c);
 
 /* If 'c' is within the list 'l', return the index */
 int findWithinList(list<char *> *l, char *c);
 
+/* The one copy of the name 's' (of 'len' bytes). Every identifier and
+ * type name in the compiler is interned, from the lexer on, so two
+ * names are the same exactly when their pointers are, and tables can
+ * be keyed on the pointer. Interned names are never freed */
+char *intern(const char *s, size_t len);
+char *intern(const char *s);
+
+/* The method behind binary operator number 'operation' (see
+ * BinaryOperatorNode): PLUS, MINUS, TIMES, DIVIDE, EQUALS, ATMOST, LESS,
+ * ATLEAST, MORE, AND, OR */
+char *operatorMethod(int operation);
+
+/* Names the compiler itself refers to */
+extern char *const NAME_OBJ;
+extern char *const NAME_INT;
+extern char *const NAME_STRING;
+extern char *const NAME_BOOLEAN;
+extern char *const NAME_NOTHING;
+extern char *const NAME_THIS;
+extern char *const NAME_TRUE;
+extern char *const NAME_FALSE;
+extern char *const NAME_UNKNOWN; // "-", the type of an expression the checker could not type
+
 #endif
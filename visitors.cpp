@@ -36,11 +36,11 @@ using std::list;
 
 void Visitor::visitProgram(Program *p) 
 {
-    for (list<Class *>::const_iterator it = p->classes->begin(); it != p->classes->end(); ++it)
+    for (NodeList<Class *>::const_iterator it = p->classes->begin(); it != p->classes->end(); ++it)
     {
         (*it)->accept(this);
     }
-    for (list<Statement *>::const_iterator it = p->statements->begin(); it != p->statements->end(); ++it)
+    for (NodeList<Statement *>::const_iterator it = p->statements->begin(); it != p->statements->end(); ++it)
     {
         (*it)->accept(this);
     }
@@ -58,7 +58,7 @@ void Visitor::visitFormalArg(FormalArg *f) {}
 
 void Visitor::visitClassSignature(ClassSignature *cs) 
 {
-    for (list<FormalArg *>::const_iterator it = cs->fargs->begin(); it != cs->fargs->end(); ++it)
+    for (NodeList<FormalArg *>::const_iterator it = cs->fargs->begin(); it != cs->fargs->end(); ++it)
     {
         (*it)->accept(this);
     }
@@ -67,11 +67,11 @@ void Visitor::visitClassSignature(ClassSignature *cs)
 
 void Visitor::visitClassBody(ClassBody *cb) 
 {
-    for (list<Statement *>::const_iterator it = cb->stmts->begin(); it != cb->stmts->end(); ++it)
+    for (NodeList<Statement *>::const_iterator it = cb->stmts->begin(); it != cb->stmts->end(); ++it)
     {
         (*it)->accept(this);
     }
-    for (list<Method *>::const_iterator it = cb->meths->begin(); it != cb->meths->end(); ++it)
+    for (NodeList<Method *>::const_iterator it = cb->meths->begin(); it != cb->meths->end(); ++it)
     {
         (*it)->accept(this);
     }
@@ -82,12 +82,12 @@ void Visitor::visitTrueIdentOption(TrueIdentOption *t) {}
 
 void Visitor::visitMethod(Method *m) 
 {
-    for (list<FormalArg *>::const_iterator it = m->fargs->begin(); it != m->fargs->end(); ++it)
+    for (NodeList<FormalArg *>::const_iterator it = m->fargs->begin(); it != m->fargs->end(); ++it)
     {
         (*it)->accept(this);
     }
     m->ident->accept(this);
-    for (list<Statement *>::const_iterator it = m->stmts->begin(); it != m->stmts->end(); ++it)
+    for (NodeList<Statement *>::const_iterator it = m->stmts->begin(); it != m->stmts->end(); ++it)
     {
         (*it)->accept(this);
     }
@@ -97,7 +97,7 @@ void Visitor::visitEmptyRExpr(EmptyRExpr *e) {}
 void Visitor::visitDotRExpr(DotRExpr *d) 
 {
     d->rexpr->accept(this);
-    for (list<RExpr *>::const_iterator it = d->args->begin(); it != d->args->end(); ++it)
+    for (NodeList<RExpr *>::const_iterator it = d->args->begin(); it != d->args->end(); ++it)
     {
         (*it)->accept(this);
     }
@@ -105,7 +105,7 @@ void Visitor::visitDotRExpr(DotRExpr *d)
 
 void Visitor::visitConstructorRExpr(ConstructorRExpr *c) 
 {
-    for (list<RExpr *>::const_iterator it = c->args->begin(); it != c->args->end(); ++it)
+    for (NodeList<RExpr *>::const_iterator it = c->args->begin(); it != c->args->end(); ++it)
     {
         (*it)->accept(this);
     }
@@ -150,7 +150,7 @@ void Visitor::visitAssignmentStatement(AssignmentStatement *a)
 void Visitor::visitWhileStatement(WhileStatement *w) 
 {
     w->rexpr->accept(this);
-    for (list<Statement *>::const_iterator it = w->stmts->begin(); it != w->stmts->end(); ++it)
+    for (NodeList<Statement *>::const_iterator it = w->stmts->begin(); it != w->stmts->end(); ++it)
     {
         (*it)->accept(this);
     }
@@ -159,7 +159,7 @@ void Visitor::visitWhileStatement(WhileStatement *w)
 void Visitor::visitIfBlock(IfBlock *i) 
 {
     i->_if->accept(this);
-    for (list<ElifClause *>::const_iterator it = i->_elifs->begin(); it != i->_elifs->end(); ++it)
+    for (NodeList<ElifClause *>::const_iterator it = i->_elifs->begin(); it != i->_elifs->end(); ++it)
     {
         (*it)->accept(this);
     }
@@ -169,7 +169,7 @@ void Visitor::visitIfBlock(IfBlock *i)
 void Visitor::visitIfClause(IfClause *i) 
 {
     i->rexpr->accept(this);
-    for (list<Statement *>::const_iterator it = i->stmts->begin(); it != i->stmts->end(); ++it)
+    for (NodeList<Statement *>::const_iterator it = i->stmts->begin(); it != i->stmts->end(); ++it)
     {
         (*it)->accept(this);
     }
@@ -178,7 +178,7 @@ void Visitor::visitIfClause(IfClause *i)
 void Visitor::visitElifClause(ElifClause *e) 
 {
     e->rexpr->accept(this);
-    for (list<Statement *>::const_iterator it = e->stmts->begin(); it != e->stmts->end(); ++it)
+    for (NodeList<Statement *>::const_iterator it = e->stmts->begin(); it != e->stmts->end(); ++it)
     {
         (*it)->accept(this);
     }
@@ -187,7 +187,7 @@ void Visitor::visitElifClause(ElifClause *e)
 void Visitor::visitFalseElseOption(FalseElseOption *e) {}
 void Visitor::visitTrueElseOption(TrueElseOption *e) 
 {
-    for (list<Statement *>::const_iterator it = e->stmts->begin(); it != e->stmts->end(); ++it)
+    for (NodeList<Statement *>::const_iterator it = e->stmts->begin(); it != e->stmts->end(); ++it)
     {
         (*it)->accept(this);
     }
@@ -209,18 +209,19 @@ void Visitor::visitObjectFieldLExpr(ObjectFieldLExpr *o)
 
 ConstructorVisitor::ConstructorVisitor() 
 {
-    classes.push_back((char *)"Obj");
-    classes.push_back((char *)"Int");
-    classes.push_back((char *)"String");
-    classes.push_back((char *)"Nothing");
+    classes.push_back(NAME_OBJ);
+    classes.push_back(NAME_INT);
+    classes.push_back(NAME_STRING);
+    classes.push_back(NAME_NOTHING);
+    classIndex.insert(classes.begin(), classes.end());
 }
 
 ConstructorVisitor::~ConstructorVisitor() {}
 void ConstructorVisitor::visitConstructorRExpr(ConstructorRExpr *c)
 {
-    if (!withinList(&constructors, c->id))
+    if (constructorIndex.insert(c->id).second)
         constructors.push_back(c->id);
-    for (list<RExpr *>::const_iterator it = c->args->begin(); it != c->args->end(); ++it)
+    for (NodeList<RExpr *>::const_iterator it = c->args->begin(); it != c->args->end(); ++it)
     {
         (*it)->accept(this);
     }
@@ -228,7 +229,8 @@ void ConstructorVisitor::visitConstructorRExpr(ConstructorRExpr *c)
 void ConstructorVisitor::visitClassSignature(ClassSignature *cs)
 {
     classes.push_back(cs->id);
-    for (list<FormalArg *>::const_iterator it = cs->fargs->begin(); it != cs->fargs->end(); ++it)
+    classIndex.insert(cs->id);
+    for (NodeList<FormalArg *>::const_iterator it = cs->fargs->begin(); it != cs->fargs->end(); ++it)
     {
         (*it)->accept(this);
     }
@@ -239,7 +241,7 @@ bool ConstructorVisitor::checkStructure()
 {
     for (list<char *>::const_iterator it = constructors.begin(); it != constructors.end(); ++it)
     {
-        if (!withinList(&classes, (*it)))
+        if (classIndex.count(*it) == 0)
             return false;
     }
     return true;
@@ -272,7 +274,7 @@ TypeTreeVisitor::TypeTreeVisitor()
 
 void TypeTreeVisitor::visitProgram(Program *p) 
 {
-    for (list<Class *>::const_iterator it = p->classes->begin(); it != p->classes->end(); ++it)
+    for (NodeList<Class *>::const_iterator it = p->classes->begin(); it != p->classes->end(); ++it)
     {
         (*it)->accept(this);
     }
@@ -280,8 +282,8 @@ void TypeTreeVisitor::visitProgram(Program *p)
 
 void TypeTreeVisitor::visitClassSignature(ClassSignature *cs) 
 {
-    cur = strdup(cs->id); //current class working on
-    for (list<FormalArg *>::const_iterator it = cs->fargs->begin(); it != cs->fargs->end(); ++it)
+    cur = cs->id; //current class working on
+    for (NodeList<FormalArg *>::const_iterator it = cs->fargs->begin(); it != cs->fargs->end(); ++it)
     {
         (*it)->accept(this);
     }
@@ -290,7 +292,7 @@ void TypeTreeVisitor::visitClassSignature(ClassSignature *cs)
 
 void TypeTreeVisitor::visitFalseExtendsOption(FalseExtendsOption *f) 
 {
-    tt->addSubtype(cur, strdup((char*)"Obj"));
+    tt->addSubtype(cur, NAME_OBJ);
 }
 
 void TypeTreeVisitor::visitTrueExtendsOption(TrueExtendsOption *t) 
@@ -302,7 +304,7 @@ void TypeTreeVisitor::visitMethod(Method *m)
 {
     inMethod = true;
     args = new list<char*>;
-    for (list<FormalArg *>::const_iterator it = m->fargs->begin(); it != m->fargs->end(); ++it)
+    for (NodeList<FormalArg *>::const_iterator it = m->fargs->begin(); it != m->fargs->end(); ++it)
     {
         (*it)->accept(this);
     }
@@ -321,7 +323,7 @@ void TypeTreeVisitor::visitFormalArg(FormalArg *f)
 
 void TypeTreeVisitor::visitFalseIdentOption(FalseIdentOption *f) 
 {
-    ret = strdup((char*)"Nothing");
+    ret = NAME_NOTHING;
 }
 
 void TypeTreeVisitor::visitTrueIdentOption(TrueIdentOption *t) 
@@ -340,10 +342,10 @@ TypeCheckVisitor::TypeCheckVisitor()
 {
     st = new SymbolTable(NULL);
     // Adding the built in 'variables'
-    VariableSym *t = new VariableSym(strdup((char*)"true"), strdup((char*)"Boolean"));
-    st->addVariable(strdup((char*)"true"), t);
-    VariableSym *f = new VariableSym(strdup((char*)"false"), strdup((char*)"Boolean"));
-    st->addVariable(strdup((char*)"false"), f);
+    VariableSym *t = new VariableSym(NAME_TRUE, NAME_BOOLEAN);
+    st->addVariable(NAME_TRUE, t);
+    VariableSym *f = new VariableSym(NAME_FALSE, NAME_BOOLEAN);
+    st->addVariable(NAME_FALSE, f);
 
     tt = new TypeTree();    
     errors = 0;
@@ -356,17 +358,15 @@ TypeCheckVisitor::TypeCheckVisitor()
     inClass = false;
     className = NULL;
     supertype = NULL;
-
-    mustRepeat = false;
 }
 TypeCheckVisitor::TypeCheckVisitor(TypeTree *t)
 {
     st = new SymbolTable(NULL);
     // Adding the built in 'variables'
-    VariableSym *tr = new VariableSym(strdup((char*)"true"), strdup((char*)"Boolean"));
-    st->addVariable(strdup((char*)"true"), tr);
-    VariableSym *f = new VariableSym(strdup((char*)"false"), strdup((char*)"Boolean"));
-    st->addVariable(strdup((char*)"false"), f);
+    VariableSym *tr = new VariableSym(NAME_TRUE, NAME_BOOLEAN);
+    st->addVariable(NAME_TRUE, tr);
+    VariableSym *f = new VariableSym(NAME_FALSE, NAME_BOOLEAN);
+    st->addVariable(NAME_FALSE, f);
 
     tt = t;
     errors = 0;
@@ -386,19 +386,25 @@ bool TypeCheckVisitor::check()
 
 void TypeCheckVisitor::visitProgram(Program *p)
 {
-    for (list<Class *>::const_iterator it = p->classes->begin(); it != p->classes->end(); ++it)
+    for (NodeList<Class *>::const_iterator it = p->classes->begin(); it != p->classes->end(); ++it)
     {
         (*it)->accept(this);
     }
     SymbolTable *origin = st;
     st = new SymbolTable(origin);
 
-    for (list<Statement *>::const_iterator it = p->statements->begin(); it != p->statements->end(); ++it)
+    for (NodeList<Statement *>::const_iterator it = p->statements->begin(); it != p->statements->end(); ++it)
     {
         (*it)->accept(this);
     }
     p->st = st;
     st = origin;
+
+    if (errors == 0) // settle the types every later pass reads
+    {
+        TypeResolveVisitor trv(tt);
+        p->accept(&trv);
+    }
 }
 
 void TypeCheckVisitor::visitBinaryOperatorNode(BinaryOperatorNode *b)
@@ -413,57 +419,19 @@ void TypeCheckVisitor::visitBinaryOperatorNode(BinaryOperatorNode *b)
     {
         return;
     }
-    if (strcmp(t1, (char*)"-") == 0 || strcmp(t2, (char*)"-") == 0)
+    if (t1 == NAME_UNKNOWN || t2 == NAME_UNKNOWN)
     {
         fprintf(stderr, "Compiler error. I don't know the types of this binary operator\n");
     }
 
-    if (strcmp(t1, t2) != 0)
+    if (t1 != t2)
     {
         char *msg = (char*) malloc(sizeof(char)*256);
         sprintf(msg, "%d: Syntax Error\n\tBinary opeartor type mismatch: '%s' and '%s'\n", b->lineno, t1, t2);
         addError(msg);
     }
 
-    char *op;
-
-    switch(b->operation) {
-        case 0:
-            op = (char*)"PLUS";
-            break;
-        case 1:
-            op = (char*)"MINUS";
-            break;
-        case 2:
-            op = (char*)"TIMES";
-            break;
-        case 3:
-            op = (char*)"DIVIDE";
-            break;
-        case 4:
-            op = (char*)"EQUALS";
-            break;
-        case 5:
-            op = (char*)"ATMOST";
-            break;
-        case 6:
-            op = (char*)"LESS";
-            break;
-        case 7:
-            op = (char*)"ATLEAST";
-            break;
-        case 8:
-            op = (char*)"MORE";
-            break;
-        case 9:
-            op = (char*)"AND";
-            break;
-        case 10:
-            op = (char*)"OR";
-            break;
-        default:
-            break;
-    }
+    char *op = operatorMethod(b->operation);
     MethodNode *method = tt->typeGetMethod(t1, op);
     if (method == NULL)
     {
@@ -476,6 +444,7 @@ void TypeCheckVisitor::visitBinaryOperatorNode(BinaryOperatorNode *b)
 void TypeCheckVisitor::visitAssignmentStatement(AssignmentStatement *a)
 {
     char *type;
+    bool replace = false; // of a variable already defined
     IdentNode *id = dynamic_cast<IdentNode*>(a->lexpr);
     if (id != NULL)
     {
@@ -488,21 +457,12 @@ void TypeCheckVisitor::visitAssignmentStatement(AssignmentStatement *a)
         }
         else if (defined != NULL) // If this variable has already been defined, perform LCA
         {
-            bool changed = false;
             type = tt->LCA(defined->type, getType(a->rexpr));    
             if (type == NULL)
             {
                 type = defined->type;
             } 
-            else if (strcmp(defined->type, getType(a->rexpr)) != 0)
-            {
-                changed = true;
-            }
-            st->removeVariable(defined); //remove old value 
-            if (inWhile && changed && strcmp(type, (char*)"Obj") != 0) //the type changed and we're in a while loop
-            {
-                mustRepeat = true;
-            }
+            replace = true;
         }
         else if (tio != NULL)
         {
@@ -514,8 +474,22 @@ void TypeCheckVisitor::visitAssignmentStatement(AssignmentStatement *a)
         }
         if (type == NULL)
             return;
-        VariableSym *v = new VariableSym(id->id, strdup(type));
-        st->addVariable(strdup(id->id), v);
+        auto floor = loopFloors.find(id->id);
+        if (floor != loopFloors.end()) // first assigned in a loop being checked
+        {
+            char *joined = tt->LCA(type, floor->second); // the type it has on later iterations
+            if (joined != NULL)
+                type = joined;
+        }
+        if (replace)
+        {
+            st->setVariable(id->id, type);
+        }
+        else
+        {
+            VariableSym *v = new VariableSym(id->id, type);
+            st->addVariable(id->id, v);
+        }
     }
     ObjectFieldLExpr *ofl = dynamic_cast<ObjectFieldLExpr*>(a->lexpr);
     if (ofl != NULL) 
@@ -523,10 +497,10 @@ void TypeCheckVisitor::visitAssignmentStatement(AssignmentStatement *a)
         IdentNode *ident = isIdent(ofl->rexpr);
         if (ident != NULL)
         {
-            if (strcmp(ident->id, (char*)"this") == 0)
+            if (ident->id == NAME_THIS)
             {
-                VariableNode *v = new VariableNode(strdup(ofl->id), strdup(getType(a->rexpr)));
-                tt->addVarToType(strdup(className), v);
+                VariableNode *v = new VariableNode(ofl->id, getType(a->rexpr));
+                tt->addVarToType(className, v);
             }
         } 
     }
@@ -537,7 +511,7 @@ void TypeCheckVisitor::visitAssignmentStatement(AssignmentStatement *a)
 
 void TypeCheckVisitor::visitIdentNode(IdentNode *i) 
 {
-    if (strcmp(i->id, (char*)"this") == 0) {
+    if (i->id == NAME_THIS) {
         return;
     }
 }
@@ -547,7 +521,7 @@ void TypeCheckVisitor::visitDotRExpr(DotRExpr *d)
     // visit first, collect args
     list<char*> args;
     d->rexpr->accept(this);
-    for (list<RExpr *>::const_iterator it = d->args->begin(); it != d->args->end(); ++it)
+    for (NodeList<RExpr *>::const_iterator it = d->args->begin(); it != d->args->end(); ++it)
     {
         (*it)->accept(this);
         args.push_back(getType((*it)));
@@ -577,7 +551,7 @@ void TypeCheckVisitor::visitDotRExpr(DotRExpr *d)
         list<char*>::const_iterator arg = args.begin(); 
         for (int i = 0; i < m->argsType.size(); i++)
         {
-            if (strcmp((*methodArgs), (*arg)) != 0)
+            if ((*methodArgs) != (*arg))
             {
                 if (!tt->isSubtype((*arg),(*methodArgs)))
                 {
@@ -594,59 +568,46 @@ void TypeCheckVisitor::visitDotRExpr(DotRExpr *d)
 
 void TypeCheckVisitor::visitConstructorRExpr(ConstructorRExpr *c)
 {
-    for (list<RExpr *>::const_iterator it = c->args->begin(); it != c->args->end(); ++it)
+    for (NodeList<RExpr *>::const_iterator it = c->args->begin(); it != c->args->end(); ++it)
     {
         (*it)->accept(this);
     }
 }
 
+/* Each branch gets a scope of its own on top of 'origin'. Afterwards
+ * 'origin' gains the variables every branch defines, and each branch
+ * keeps only the ones it alone defines, for code generation */
 void TypeCheckVisitor::visitIfBlock(IfBlock *i)
 {
     list<SymbolTable*> sts;
     SymbolTable *origin = st;
     st = new SymbolTable(origin);
     sts.push_back(st);
-
+    i->_if->st = st;
     i->_if->accept(this);
-    SymbolTable *if_st = st;
 
-    list<SymbolTable *> elif_sts;
-    for (list<ElifClause *>::const_iterator it = i->_elifs->begin(); it != i->_elifs->end(); ++it)
+    for (NodeList<ElifClause *>::const_iterator it = i->_elifs->begin(); it != i->_elifs->end(); ++it)
     {
         st = new SymbolTable(origin);
         sts.push_back(st);
+        (*it)->st = st;
         (*it)->accept(this);
-        elif_sts.push_back(st);
     }
 
-    SymbolTable *else_st;
+    // A missing else is an empty branch: what the others define may be unset
+    st = new SymbolTable(origin);
+    sts.push_back(st);
+    i->_else->st = st;
     TrueElseOption *tso = dynamic_cast<TrueElseOption*>(i->_else);
     if (tso != NULL)
-    {
-        st = new SymbolTable(origin);
-        sts.push_back(st);
         i->_else->accept(this);
-        else_st = st;
-    } 
-    else 
-    {
-        else_st = if_st;
-    }
-
-    st = sts.front()->intersection(sts, tt);
-    st->merge(origin);
 
-    // This removes the higher level variables from the local-if sym table
-    i->_if->st = if_st->remove(if_st, st);
-
-    auto iter = elif_sts.begin();
-    for (list<ElifClause *>::const_iterator it = i->_elifs->begin(); it != i->_elifs->end(); ++it)
+    st = origin;
+    st->join(sts, tt);
+    for (list<SymbolTable*>::const_iterator it = sts.begin(); it != sts.end(); ++it)
     {
-        (*it)->st = (*iter)->remove((*iter), st);
-        iter++;
+        (*it)->removeHeldBy(st);
     }
-    
-    i->_else->st = else_st->remove(else_st, st);
 }
 
 void TypeCheckVisitor::visitIfClause(IfClause *i)
@@ -654,14 +615,14 @@ void TypeCheckVisitor::visitIfClause(IfClause *i)
     char *type;
     type = getType(i->rexpr);
 
-    if (strcmp(type, (char*)"Boolean") != 0)
+    if (type != NAME_BOOLEAN)
     {
         char *msg = (char*) malloc(sizeof(char)*256);
         sprintf(msg, "%d: Syntax Error\n\tIf condition must be of type 'Boolean'\n", i->lineno);
         addError(msg);
     }
     i->rexpr->accept(this);
-    for (list<Statement *>::const_iterator it = i->stmts->begin(); it != i->stmts->end(); ++it)
+    for (NodeList<Statement *>::const_iterator it = i->stmts->begin(); it != i->stmts->end(); ++it)
     {
         (*it)->accept(this);
     }
@@ -672,14 +633,14 @@ void TypeCheckVisitor::visitElifClause(ElifClause *e)
     char *type;
     type = getType(e->rexpr);
 
-    if (strcmp(type, (char*)"Boolean") != 0)
+    if (type != NAME_BOOLEAN)
     {
         char *msg = (char*) malloc(sizeof(char)*256);
         sprintf(msg, "%d: Syntax Error\n\tElif condition must be of type 'Boolean'\n", e->lineno);
         addError(msg);
     }
     e->rexpr->accept(this);
-    for (list<Statement *>::const_iterator it = e->stmts->begin(); it != e->stmts->end(); ++it)
+    for (NodeList<Statement *>::const_iterator it = e->stmts->begin(); it != e->stmts->end(); ++it)
     {
         (*it)->accept(this);
     }
@@ -687,34 +648,69 @@ void TypeCheckVisitor::visitElifClause(ElifClause *e)
 
 void TypeCheckVisitor::visitTrueElseOption(TrueElseOption *e)
 {
-    for (list<Statement *>::const_iterator it = e->stmts->begin(); it != e->stmts->end(); ++it)
+    for (NodeList<Statement *>::const_iterator it = e->stmts->begin(); it != e->stmts->end(); ++it)
     {
         (*it)->accept(this);
     }
 }
 
+/* A variable assigned in the loop may reach the head of the loop with a
+ * wider type than it had before it. The loop is checked once, with each
+ * variable given the type TypeFlow found it has on every iteration */
 void TypeCheckVisitor::visitWhileStatement(WhileStatement *w)
 {
-    inWhile = true;
+    bool outermost = loopTypes.empty();
+    if (outermost)
+        inferLoopTypes(w);
+    TypeFlow::Fact &types = loopTypes[w];
+    for (TypeFlow::Fact::const_iterator it = types.begin(); it != types.end(); ++it)
+    {
+        VariableSym *v = st->lookupVariable(it->first);
+        if (v == NULL)
+        {
+            loopFloors[it->first] = it->second;
+            continue;
+        }
+        char *joined = tt->LCA(v->type, it->second);
+        if (joined != NULL && joined != v->type)
+            st->setVariable(it->first, joined);
+    }
+
     char *type = getType(w->rexpr);
-    if (type != NULL && strcmp(type, (char*)"Boolean") != 0)
+    if (type != NULL && type != NAME_BOOLEAN)
     {
         char *msg = (char*) malloc(sizeof(char)*256);
         sprintf(msg, "%d: Syntax Error\n\tWhile condition must be of type 'Boolean'\n", w->lineno);
         addError(msg);
     }
     w->rexpr->accept(this);
-    for (list<Statement *>::const_iterator it = w->stmts->begin(); it != w->stmts->end(); ++it)
+    for (NodeList<Statement *>::const_iterator it = w->stmts->begin(); it != w->stmts->end(); ++it)
     {
         (*it)->accept(this);
-        while (mustRepeat)
-        {
-            mustRepeat = false;
-            (*it)->accept(this);
-        }
     }
     w->st = st;
-    inWhile = false;
+    if (outermost)
+    {
+        loopTypes.clear();
+        loopFloors.clear();
+    }
+}
+
+// Run TypeFlow over the outermost loop 'w', starting from the variables
+// in scope, and keep the fact at the head of each loop in it
+void TypeCheckVisitor::inferLoopTypes(WhileStatement *w)
+{
+    NodeList<Statement *> body;
+    body.push_back(w);
+    CFG cfg(&body);
+    TypeFlow flow(tt, st, className);
+    vector<TypeFlow::Fact> in;
+    forwardDataflow(&cfg, flow, in);
+    for (vector<CFGNode *>::const_iterator it = cfg.nodes.begin(); it != cfg.nodes.end(); ++it)
+    {
+        if ((*it)->kind == CFGNode::LOOP)
+            loopTypes[(WhileStatement *) (*it)->stmt] = in[(*it)->index];
+    }
 }
 
 void TypeCheckVisitor::visitMethod(Method *m)
@@ -740,7 +736,7 @@ void TypeCheckVisitor::visitMethod(Method *m)
             list<char*>::const_iterator overrideArgs = override->argsType.begin();                                              
             for (int i = 0; i < superMethod->argsType.size(); i++)                                                              
             {                                                                                                  
-                if (strcmp((*superArgs), (*overrideArgs)) != 0)                                                    
+                if ((*superArgs) != (*overrideArgs))                                                    
                 {
                     if (!tt->isSupertype((*overrideArgs),(*superArgs)))
                     {
@@ -753,7 +749,7 @@ void TypeCheckVisitor::visitMethod(Method *m)
                 std::advance(overrideArgs, 1);
             }
             //check return statement
-            if (strcmp(superMethod->returnType, override->returnType) != 0)
+            if (superMethod->returnType != override->returnType)
             {
                 if (!tt->isSubtype(override->returnType, superMethod->returnType))
                 {
@@ -765,14 +761,14 @@ void TypeCheckVisitor::visitMethod(Method *m)
         }        
     }
     //
-    for (list<FormalArg *>::const_iterator it = m->fargs->begin(); it != m->fargs->end(); ++it)
+    for (NodeList<FormalArg *>::const_iterator it = m->fargs->begin(); it != m->fargs->end(); ++it)
     {
         (*it)->accept(this);
     }
     inMethodReturnCheck = true;
     m->ident->accept(this);
     inMethodReturnCheck = false;
-    for (list<Statement *>::const_iterator it = m->stmts->begin(); it != m->stmts->end(); ++it)
+    for (NodeList<Statement *>::const_iterator it = m->stmts->begin(); it != m->stmts->end(); ++it)
     {
         (*it)->accept(this);
     }
@@ -793,7 +789,7 @@ void TypeCheckVisitor::visitTrueIdentOption(TrueIdentOption *t)
 {
     if (inMethodReturnCheck)
     {
-        if (strcmp(t->id, (char*)"Nothing") == 0)
+        if (t->id == NAME_NOTHING)
         {
             returned = true;  //assume method returns nothing
         }
@@ -805,7 +801,7 @@ void TypeCheckVisitor::visitFalseIdentOption(FalseIdentOption *f)
 {
     if (inMethodReturnCheck)
     {
-        returnType = strdup((char*)"Nothing");
+        returnType = NAME_NOTHING;
         returned = true; // by default, assume the method returns nothing
     }
 }
@@ -823,7 +819,7 @@ void TypeCheckVisitor::visitReturnStatement(ReturnStatement *r)
     r->rexpr->accept(this);
     type = getType(r->rexpr);
 
-    if (strcmp(type, returnType) != 0)
+    if (type != returnType)
     {
         if (!tt->isSubtype(type, returnType))
         {
@@ -856,7 +852,7 @@ void TypeCheckVisitor::visitClass(Class *c)
 
 void TypeCheckVisitor::visitClassSignature(ClassSignature *cs) 
 {
-    for (list<FormalArg *>::const_iterator it = cs->fargs->begin(); it != cs->fargs->end(); ++it)
+    for (NodeList<FormalArg *>::const_iterator it = cs->fargs->begin(); it != cs->fargs->end(); ++it)
     {
         (*it)->accept(this);
     }
@@ -865,7 +861,7 @@ void TypeCheckVisitor::visitClassSignature(ClassSignature *cs)
 
 void TypeCheckVisitor::visitClassBody(ClassBody *cb)  
 {
-    for (list<Statement *>::const_iterator it = cb->stmts->begin(); it != cb->stmts->end(); ++it)
+    for (NodeList<Statement *>::const_iterator it = cb->stmts->begin(); it != cb->stmts->end(); ++it)
     {
         (*it)->accept(this);
     }
@@ -875,7 +871,7 @@ void TypeCheckVisitor::visitClassBody(ClassBody *cb)
      * the class scope once this is done. Instance variables are retained because they 
      * exist in the TypeTree. */
     st = beyondConstructorScope;
-    for (list<Method *>::const_iterator it = cb->meths->begin(); it != cb->meths->end(); ++it)
+    for (NodeList<Method *>::const_iterator it = cb->meths->begin(); it != cb->meths->end(); ++it)
     {
         (*it)->accept(this);
     }
@@ -883,8 +879,8 @@ void TypeCheckVisitor::visitClassBody(ClassBody *cb)
 
 void TypeCheckVisitor::visitFormalArg(FormalArg *f)
 {
-    VariableSym *v = new VariableSym(strdup(f->id), strdup(f->type));
-    st->addVariable(strdup(f->id), v);
+    VariableSym *v = new VariableSym(f->id, f->type);
+    st->addVariable(f->id, v);
 }
 
 void TypeCheckVisitor::addError(char *msg)
@@ -922,17 +918,37 @@ ObjectFieldLExpr *TypeCheckVisitor::isOFL(RExpr *r)
     return NULL;
 }
 
+/* The type of 'r' is worked out once for each scope and version of the
+ * tables; the expressions around 'r' ask for it again. A type whose
+ * working out reported an error is not kept, so the error is reported
+ * each time, as before */
 char *TypeCheckVisitor::getType(RExpr *r)
+{
+    unsigned long now = SymbolTable::changes + tt->changes;
+    if (r->resolvedType != NULL && r->resolvedIn == st && r->resolvedAt == now)
+        return r->resolvedType;
+    int before = errors;
+    char *type = computeType(r);
+    if (errors == before)
+    {
+        r->resolvedType = type;
+        r->resolvedIn = st;
+        r->resolvedAt = now;
+    }
+    return type;
+}
+
+char *TypeCheckVisitor::computeType(RExpr *r)
 {
     char *type;
     type = r->type();
-    if (strcmp(type, (char*)"-") != 0) //type covered because it's a literal or easy to identify
+    if (type != NAME_UNKNOWN) //type covered because it's a literal or easy to identify
         return type;
 
     IdentNode *ident = isIdent(r);
     if (ident != NULL) //type is in the variable information
     {
-        if (strcmp(ident->id, (char*)"this") == 0)
+        if (ident->id == NAME_THIS)
         {
             return className;
         }
@@ -954,7 +970,7 @@ char *TypeCheckVisitor::getType(RExpr *r)
         MethodNode *m = tt->typeGetMethod(_type, dot->id);
         if (m == NULL)
         {
-            return strdup((char*)"-");
+            return NAME_UNKNOWN;
         }
         return m->returnType;
     }
@@ -964,14 +980,14 @@ char *TypeCheckVisitor::getType(RExpr *r)
     {
         char *rType = getType(ofl->rexpr);
         if (rType == NULL)
-            return strdup((char*)"-");
+            return NAME_UNKNOWN;
         char *__type = tt->getVarFromType(rType, ofl->id);
         if (__type == NULL)
         {
             char *msg = (char*) malloc(sizeof(char)*256);
             sprintf(msg, "%d: Syntax Error\n\tType '%s' has no instance variable '%s'\n", r->lineno, rType, ofl->id);
             addError(msg);
-            return strdup((char*)"-");
+            return NAME_UNKNOWN;
         }
         return __type;
     }
@@ -997,5 +1013,229 @@ char *TypeCheckVisitor::getType(RExpr *r)
         return getType(divide->left);
     }
 
-    return strdup((char*)"-");
+    return NAME_UNKNOWN;
+}
+
+
+/*********************
+ *
+ * Defining TypeResolveVisitor methods
+ *
+ ***********************/
+
+TypeResolveVisitor::TypeResolveVisitor(TypeTree *t)
+{
+    tt = t;
+    className = NULL;
+}
+
+void TypeResolveVisitor::visitProgram(Program *p)
+{
+    for (NodeList<Class *>::const_iterator it = p->classes->begin(); it != p->classes->end(); ++it)
+    {
+        (*it)->accept(this);
+    }
+    scopes.push_back(unordered_map<char *, char *>());
+    declareLocals(p->st);
+    for (NodeList<Statement *>::const_iterator it = p->statements->begin(); it != p->statements->end(); ++it)
+    {
+        (*it)->accept(this);
+    }
+    scopes.pop_back();
+}
+
+// The constructor's scope holds its arguments, then the locals of the class body
+void TypeResolveVisitor::visitClassSignature(ClassSignature *cs)
+{
+    className = cs->id;
+    scopes.push_back(unordered_map<char *, char *>());
+    for (NodeList<FormalArg *>::const_iterator it = cs->fargs->begin(); it != cs->fargs->end(); ++it)
+    {
+        scopes.back()[(*it)->id] = (*it)->type;
+    }
+}
+
+void TypeResolveVisitor::visitClassBody(ClassBody *cb)
+{
+    declareLocals(cb->st);
+    scopes.back()[NAME_THIS] = className;
+    for (NodeList<Statement *>::const_iterator it = cb->stmts->begin(); it != cb->stmts->end(); ++it)
+    {
+        (*it)->accept(this);
+    }
+    scopes.pop_back();
+    for (NodeList<Method *>::const_iterator it = cb->meths->begin(); it != cb->meths->end(); ++it)
+    {
+        (*it)->accept(this);
+    }
+}
+
+void TypeResolveVisitor::visitMethod(Method *m)
+{
+    scopes.push_back(unordered_map<char *, char *>());
+    scopes.back()[NAME_THIS] = className;
+    for (NodeList<FormalArg *>::const_iterator it = m->fargs->begin(); it != m->fargs->end(); ++it)
+    {
+        scopes.back()[(*it)->id] = (*it)->type;
+    }
+    declareLocals(m->st);
+    for (NodeList<Statement *>::const_iterator it = m->stmts->begin(); it != m->stmts->end(); ++it)
+    {
+        (*it)->accept(this);
+    }
+    scopes.pop_back();
+}
+
+void TypeResolveVisitor::visitIfClause(IfClause *i)
+{
+    i->rexpr->accept(this);
+    resolveBlock(i->st, i->stmts);
+}
+
+void TypeResolveVisitor::visitElifClause(ElifClause *e)
+{
+    e->rexpr->accept(this);
+    resolveBlock(e->st, e->stmts);
+}
+
+void TypeResolveVisitor::visitTrueElseOption(TrueElseOption *e)
+{
+    resolveBlock(e->st, e->stmts);
+}
+
+void TypeResolveVisitor::visitEmptyRExpr(EmptyRExpr *e)
+{
+    resolve(e);
+}
+
+void TypeResolveVisitor::visitDotRExpr(DotRExpr *d)
+{
+    Visitor::visitDotRExpr(d);
+    resolve(d);
+}
+
+void TypeResolveVisitor::visitConstructorRExpr(ConstructorRExpr *c)
+{
+    Visitor::visitConstructorRExpr(c);
+    resolve(c);
+}
+
+void TypeResolveVisitor::visitRExprToLExpr(RExprToLExpr *rl)
+{
+    Visitor::visitRExprToLExpr(rl);
+    resolve(rl);
+}
+
+void TypeResolveVisitor::visitStringNode(StringNode *s)
+{
+    resolve(s);
+}
+
+void TypeResolveVisitor::visitIntNode(IntNode *i)
+{
+    resolve(i);
+}
+
+void TypeResolveVisitor::visitNotNode(NotNode *n)
+{
+    Visitor::visitNotNode(n);
+    resolve(n);
+}
+
+void TypeResolveVisitor::visitBinaryOperatorNode(BinaryOperatorNode *b)
+{
+    Visitor::visitBinaryOperatorNode(b);
+    resolve(b);
+}
+
+/* Store the type of 'r', whose subexpressions are resolved already.
+ * Anything whose type is not known is an Obj */
+void TypeResolveVisitor::resolve(RExpr *r)
+{
+    char *type = r->type();
+    if (type != NAME_UNKNOWN) //type covered because it's a literal or easy to identify
+    {
+        r->resolvedType = type;
+        return;
+    }
+    RExprToLExpr *rl = dynamic_cast<RExprToLExpr*>(r);
+    DotRExpr *dot = dynamic_cast<DotRExpr*>(r);
+    BinaryOperatorNode *b = dynamic_cast<BinaryOperatorNode*>(r);
+    if (rl != NULL)
+    {
+        IdentNode *ident = dynamic_cast<IdentNode*>(rl->lexpr);
+        ObjectFieldLExpr *ofl = dynamic_cast<ObjectFieldLExpr*>(rl->lexpr);
+        if (ident != NULL && (ident->id == NAME_TRUE || ident->id == NAME_FALSE))
+            type = NAME_BOOLEAN;
+        else if (ident != NULL)
+            type = lookup(ident->id);
+        else if (ofl != NULL)
+            type = tt->getVarFromType(ofl->rexpr->resolvedType, ofl->id);
+    }
+    else if (dot != NULL)
+    {
+        MethodNode *m = tt->typeGetMethod(dot->rexpr->resolvedType, dot->id);
+        type = m != NULL ? m->returnType : NULL;
+    }
+    else if (b != NULL)
+    {
+        if (b->operation >= 4) // comparisons and logic
+        {
+            type = NAME_BOOLEAN;
+        }
+        else
+        {
+            MethodNode *m = tt->typeGetMethod(b->left->resolvedType, operatorMethod(b->operation));
+            type = m != NULL ? m->returnType : b->left->resolvedType;
+        }
+    }
+    if (type == NULL || type == NAME_UNKNOWN)
+        type = NAME_OBJ;
+    r->resolvedType = type;
+}
+
+/* Declare the variables of 'vars' that are not visible already with the
+ * same type or a supertype, and drop the others from 'vars' */
+void TypeResolveVisitor::declareLocals(SymbolTable *vars)
+{
+    list<VariableSym *> visible;
+    for (unordered_map<char *, VariableSym*>::iterator it = vars->vMap.begin(); it != vars->vMap.end(); ++it)
+    {
+        char *name = (*it).first;
+        char *type = (*it).second->type;
+        char *v = lookup(name);
+        if (tt->findType(type) == NULL)
+            visible.push_back((*it).second); // never declared
+        else if (v != NULL && (v == type || tt->isSubtype(type, v)))
+            visible.push_back((*it).second); // an argument, or a variable of the enclosing block
+        else
+            scopes.back()[name] = type;
+    }
+    for (list<VariableSym *>::const_iterator it = visible.begin(); it != visible.end(); ++it)
+    {
+        vars->removeVariable(*it);
+    }
+}
+
+// The body of an if/elif/else is a scope of its own
+void TypeResolveVisitor::resolveBlock(SymbolTable *blockSt, NodeList<Statement *> *stmts)
+{
+    scopes.push_back(unordered_map<char *, char *>());
+    declareLocals(blockSt);
+    for (NodeList<Statement *>::const_iterator it = stmts->begin(); it != stmts->end(); ++it)
+    {
+        (*it)->accept(this);
+    }
+    scopes.pop_back();
+}
+
+char *TypeResolveVisitor::lookup(char *name)
+{
+    for (vector<unordered_map<char *, char *> >::reverse_iterator it = scopes.rbegin(); it != scopes.rend(); ++it)
+    {
+        auto v = it->find(name);
+        if (v != it->end())
+            return v->second;
+    }
+    return NULL;
 }
@@ -9,20 +9,28 @@
  * ConstructorVisitor: traverses the AST, checks that constructor calls are valid
  * TypeTreeVisitor: traverses the AST, constructs the type tree
  * TypeCheckVisitor: traverses the AST, performs static type checking
+ * TypeResolveVisitor: traverses the checked AST, settles the type of every expression
  *
  * */ 
 #ifndef VISITOR_H 
 #define VISITOR_H
 
 #include <list>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <stdio.h>
 
+#include "CFG.hpp"
 #include "nodes.hpp"
 #include "SymbolTable.hpp"
 #include "TypeTree.hpp"
 
 using std::list;
+using std::unordered_map;
+using std::unordered_set;
+using std::vector;
 
 /* Visitor defines a visitor that traverses the AST without doing
  * any meaningful analysis
@@ -72,6 +80,9 @@ class ConstructorVisitor : public Visitor
     private:
         list<char *> constructors;
         list<char *> classes;
+        // What the lists hold, for lookups that do not scan them
+        unordered_set<char *> constructorIndex;
+        unordered_set<char *> classIndex;
     public:
         ConstructorVisitor();
         ~ConstructorVisitor();
@@ -159,8 +170,12 @@ class TypeCheckVisitor : public Visitor
         char *className;
         char *supertype;
 
-        bool inWhile;
-        bool mustRepeat;
+        // What TypeFlow found at the head of each loop of the outermost
+        // loop being checked, and the types the variables first assigned
+        // in it reach
+        unordered_map<WhileStatement *, TypeFlow::Fact> loopTypes;
+        unordered_map<char *, char *> loopFloors;
+        void inferLoopTypes(WhileStatement *w);
 
         SymbolTable *beyondConstructorScope;
 
@@ -168,6 +183,48 @@ class TypeCheckVisitor : public Visitor
         ObjectFieldLExpr *isOFL(RExpr *r);
 
         char *getType(RExpr *r);
+        char *computeType(RExpr *r);
+};
+
+/* The TypeResolveVisitor runs once type checking has succeeded. It
+ * stores the final type of every RExpr in its resolvedType, seeing the
+ * variables of each block the way the generated C declares them: a
+ * block declares a variable unless an enclosing one is visible with
+ * the same type or a supertype. What it leaves in each block's
+ * SymbolTable is exactly what the block declares
+ *
+ * */
+class TypeResolveVisitor : public Visitor
+{
+    public:
+        TypeTree *tt;
+
+        TypeResolveVisitor(TypeTree *t);
+        virtual void visitProgram(Program *p);
+        virtual void visitClassSignature(ClassSignature *cs);
+        virtual void visitClassBody(ClassBody *cb);
+        virtual void visitMethod(Method *m);
+        virtual void visitIfClause(IfClause *i);
+        virtual void visitElifClause(ElifClause *e);
+        virtual void visitTrueElseOption(TrueElseOption *e);
+
+        virtual void visitEmptyRExpr(EmptyRExpr *e);
+        virtual void visitDotRExpr(DotRExpr *d);    
+        virtual void visitConstructorRExpr(ConstructorRExpr *c);
+        virtual void visitRExprToLExpr(RExprToLExpr *rl);
+        virtual void visitStringNode(StringNode *s);
+        virtual void visitIntNode(IntNode *i);
+        virtual void visitNotNode(NotNode *n);
+        virtual void visitBinaryOperatorNode(BinaryOperatorNode *b);
+
+    private:
+        char *className;
+        vector<unordered_map<char *, char *> > scopes; // variable name to type
+
+        void resolve(RExpr *r);
+        void declareLocals(SymbolTable *vars);
+        void resolveBlock(SymbolTable *blockSt, NodeList<Statement *> *stmts);
+        char *lookup(char *name);
 };
 
 #endif